@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCBatchReader_h
+#define itkSWCBatchReader_h
+#include "IOMeshSWCExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSWCParser.h"
+
+namespace itk
+{
+
+/**
+ *\class SWCBatchReader
+ * \brief Parse many SWC files concurrently.
+ *
+ * SWCBatchReader parses a list of SWC files with the tokenizer used by
+ * SWCMeshIO, distributing the files over a thread pool. Each work unit
+ * reuses its own read buffer for all the files it parses, and no MeshIO is
+ * created per file. Update produces one record per file, in the order the
+ * files were given. A file that cannot be opened or parsed yields a record
+ * with an error message and does not affect the other files. Gzip-compressed
+ * files are decompressed as they are parsed.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCBatchReader : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SWCBatchReader);
+
+  /** Standard class type aliases. */
+  using Self = SWCBatchReader;
+  using Superclass = Object;
+  using ConstPointer = SmartPointer<const Self>;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(SWCBatchReader);
+
+  using FileNamesContainer = std::vector<std::string>;
+  using HeaderContentType = std::vector<std::string>;
+
+  /** Parsed content of one file, as structure-of-arrays buffers. */
+  struct RecordType
+  {
+    std::string              FileName;
+    bool                     Succeeded{ false };
+    std::string              ErrorMessage;
+    HeaderContentType        HeaderContent;
+    SWCParser::SampleBuffers Samples;
+  };
+  using RecordContainerType = std::vector<RecordType>;
+
+  void
+  SetFileNames(const FileNamesContainer & fileNames);
+
+  const FileNamesContainer &
+  GetFileNames() const
+  {
+    return m_FileNames;
+  }
+
+  void
+  AddFileName(const std::string & fileName);
+
+  /** Add the files matching a glob pattern such as "data/[0-9]*.swc", in sorted
+   * order. Returns the number of files added. */
+  SizeValueType
+  AddFileNamesFromGlob(const std::string & pattern);
+
+  /** Set/Get the number of work units the files are distributed over. The
+   * default is the global default number of threads. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
+  /** Parse all files. Errors are reported per record and never thrown. */
+  void
+  Update();
+
+  const RecordContainerType &
+  GetRecords() const
+  {
+    return m_Records;
+  }
+
+  const RecordType &
+  GetRecord(SizeValueType index) const
+  {
+    return m_Records[index];
+  }
+
+  SizeValueType
+  GetNumberOfRecords() const
+  {
+    return m_Records.size();
+  }
+
+  /** Number of records of the last Update that failed. */
+  itkGetConstMacro(NumberOfFailures, SizeValueType);
+
+protected:
+  SWCBatchReader();
+  ~SWCBatchReader() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Parse record.FileName into record, reusing blockBuffer. */
+  static void
+  ReadRecord(RecordType & record, std::vector<char> & blockBuffer);
+
+private:
+  FileNamesContainer  m_FileNames;
+  RecordContainerType m_Records;
+  ThreadIdType        m_NumberOfWorkUnits;
+  SizeValueType       m_NumberOfFailures{ 0 };
+};
+} // end namespace itk
+
+#endif
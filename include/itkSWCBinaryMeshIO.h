@@ -0,0 +1,110 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCBinaryMeshIO_h
+#define itkSWCBinaryMeshIO_h
+#include "IOMeshSWCExport.h"
+
+#include "itkSWCMeshIO.h"
+
+namespace itk
+{
+
+/**
+ *\class SWCBinaryMeshIO
+ * \brief Read and write SWC reconstructions in the binary SWCB format.
+ *
+ * SWCB stores the parsed content of an SWC file so that it can be reloaded
+ * without parsing text. A file is a 48 byte little-endian header followed by
+ * sections that each start on an 8 byte boundary:
+ *
+ *  - header: "SWCB", uint32 version, uint32 point dimension, uint32 flags,
+ *    uint64 number of samples, uint64 number of cells, uint64 cell buffer
+ *    size and uint64 header content length in bytes. Flag bit 0 is set when
+ *    the points are stored as float64.
+ *  - header content: the SWC comment lines, each terminated by '\n'
+ *  - int64 sample identifiers
+ *  - float32 type identifiers
+ *  - float32 or float64 points, interleaved by dimension
+ *  - float64 radii
+ *  - int64 parent identifiers
+ *  - uint32 cell buffer in the layout returned by ReadCells
+ *
+ * Each section is read with a single bulk read into the containers handed
+ * out by ReadPoints, ReadCells and ReadPointData. Section offsets follow
+ * from the header alone, so the file can also be memory-mapped.
+ *
+ * Points are written at the precision they are held in: float64 when they
+ * were read or written as double, float32 otherwise. They are read back at
+ * that precision, or in double precision when DOUBLE is requested, and
+ * ReadPoints converts them to a requested point component type.
+ *
+ * ConvertSWCToSWCB parses the coordinates in double precision and
+ * ConvertSWCBToSWC keeps the stored precision, so that converting between
+ * the text and binary formats does not change any sample value.
+ *
+ * \ingroup IOFilters
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCBinaryMeshIO : public SWCMeshIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SWCBinaryMeshIO);
+
+  /** Standard class type aliases. */
+  using Self = SWCBinaryMeshIO;
+  using Superclass = SWCMeshIO;
+  using ConstPointer = SmartPointer<const Self>;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(SWCBinaryMeshIO);
+
+  /** Version of the SWCB format written by this class. */
+  static constexpr uint32_t FormatVersion = 1;
+
+  bool
+  CanReadFile(const char * fileName) override;
+
+  void
+  ReadMeshInformation() override;
+
+  bool
+  CanWriteFile(const char * fileName) override;
+
+  void
+  Write() override;
+
+  /** Convert an SWC file to SWCB. */
+  static void
+  ConvertSWCToSWCB(const std::string & swcFileName, const std::string & swcbFileName);
+
+  /** Convert an SWCB file to SWC. */
+  static void
+  ConvertSWCBToSWC(const std::string & swcbFileName, const std::string & swcFileName);
+
+protected:
+  SWCBinaryMeshIO();
+  ~SWCBinaryMeshIO() override;
+};
+} // end namespace itk
+
+#endif
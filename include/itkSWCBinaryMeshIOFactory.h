@@ -0,0 +1,75 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSWCBinaryMeshIOFactory_h
+#define itkSWCBinaryMeshIOFactory_h
+#include "IOMeshSWCExport.h"
+
+#include "itkMeshIOBase.h"
+#include "itkObjectFactoryBase.h"
+
+namespace itk
+{
+/**
+ *\class SWCBinaryMeshIOFactory
+ * \brief Create instances of SWCBinaryMeshIO objects using an object factory.
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCBinaryMeshIOFactory : public ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SWCBinaryMeshIOFactory);
+
+  /** Standard class type aliases. */
+  using Self = SWCBinaryMeshIOFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char *
+  GetITKSourceVersion() const override;
+
+  const char *
+  GetDescription() const override;
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(SWCBinaryMeshIOFactory);
+
+  /** Register one factory of this type  */
+  static void
+  RegisterOneFactory()
+  {
+    auto swcbFactory = SWCBinaryMeshIOFactory::New();
+
+    ObjectFactoryBase::RegisterFactoryInternal(swcbFactory);
+  }
+
+protected:
+  SWCBinaryMeshIOFactory();
+  ~SWCBinaryMeshIOFactory() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCFileStream_h
+#define itkSWCFileStream_h
+#include "IOMeshSWCExport.h"
+
+#include "itkIntTypes.h"
+
+#include <fstream>
+#include <string>
+
+struct gzFile_s;
+
+namespace itk
+{
+
+/**
+ *\class SWCInputFileStream
+ * \brief Reads the bytes of a plain or gzip-compressed SWC file.
+ *
+ * The compression is detected from the gzip magic number, not from the file
+ * name, and the data is decompressed with ITK's zlib as it is read. Read has
+ * the signature SWCParser::ParseInput expects.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCInputFileStream
+{
+public:
+  SWCInputFileStream() = default;
+  ~SWCInputFileStream();
+  SWCInputFileStream(const SWCInputFileStream &) = delete;
+  SWCInputFileStream &
+  operator=(const SWCInputFileStream &) = delete;
+
+  /** Open fileName and clear the error state. Returns false if it cannot be
+   * opened. */
+  bool
+  Open(const std::string & fileName);
+
+  /** Read up to count bytes into destination. Returns the number of bytes
+   * read, which is 0 at the end of the file or after an error. */
+  size_t
+  Read(char * destination, size_t count);
+
+  /** Close the file. A compressed stream that ends early is also detected
+   * here, and kept in HasError until the next Open. */
+  void
+  Close();
+
+  /** Whether the file is gzip-compressed. */
+  bool
+  IsCompressed() const
+  {
+    return m_GzFile != nullptr;
+  }
+
+  /** Whether a read or the closing of the file failed, e.g. on corrupt or
+   * truncated compressed data. */
+  bool
+  HasError() const
+  {
+    return m_HasError;
+  }
+
+private:
+  std::ifstream m_Stream;
+  gzFile_s *    m_GzFile{ nullptr };
+  bool          m_HasError{ false };
+};
+
+/**
+ *\class SWCOutputFileStream
+ * \brief Writes the bytes of a plain or gzip-compressed SWC file.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCOutputFileStream
+{
+public:
+  SWCOutputFileStream() = default;
+  ~SWCOutputFileStream();
+  SWCOutputFileStream(const SWCOutputFileStream &) = delete;
+  SWCOutputFileStream &
+  operator=(const SWCOutputFileStream &) = delete;
+
+  /** Open fileName for writing. The data is gzip-compressed at
+   * compressionLevel, from 1 (fastest) to 9 (smallest), if compressionLevel
+   * is not 0. Returns false if the file cannot be opened. */
+  bool
+  Open(const std::string & fileName, int compressionLevel);
+
+  /** Write count bytes of data. Returns false on error. */
+  bool
+  Write(const char * data, size_t count);
+
+  /** Flush and close the file. Returns false if any write failed. */
+  bool
+  Close();
+
+private:
+  std::ofstream m_Stream;
+  gzFile_s *    m_GzFile{ nullptr };
+  bool          m_HasError{ false };
+};
+
+} // end namespace itk
+
+#endif
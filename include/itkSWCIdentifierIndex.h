@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCIdentifierIndex_h
+#define itkSWCIdentifierIndex_h
+#include "IOMeshSWCExport.h"
+
+#include "itkIntTypes.h"
+#include "itkNumericTraits.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ *\class SWCIdentifierIndex
+ * \brief Maps SWC sample identifiers to point indices.
+ *
+ * The lookup structure is chosen from the identifiers when the index is
+ * built:
+ *  - Offset: identifiers are contiguous and ascending, e.g. the common
+ *    identifier == index + 1 layout. No table is stored.
+ *  - Dense: identifiers span a range of at most DenseRangeFactor times the
+ *    number of samples. A direct-offset vector is used.
+ *  - Sparse: anything else. A hash map is used.
+ *
+ * When an identifier occurs more than once, its last occurrence wins.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCIdentifierIndex
+{
+public:
+  using IdentifierValueType = int64_t;
+
+  /** Returned by Find for identifiers that are not in the index. */
+  static constexpr IdentifierType InvalidIndex = NumericTraits<IdentifierType>::max();
+
+  /** Maximum ratio of identifier range to sample count for a Dense index. */
+  static constexpr SizeValueType DenseRangeFactor = 4;
+
+  enum class Mode : uint8_t
+  {
+    Offset,
+    Dense,
+    Sparse
+  };
+
+  /** Build the index for identifiers[0, numberOfIdentifiers). */
+  void
+  Build(const IdentifierValueType * identifiers, SizeValueType numberOfIdentifiers);
+
+  void
+  Clear();
+
+  /** Return the point index of identifier, or InvalidIndex. */
+  IdentifierType
+  Find(IdentifierValueType identifier) const
+  {
+    const SizeValueType offset = static_cast<SizeValueType>(identifier) - static_cast<SizeValueType>(m_Offset);
+    switch (m_Mode)
+    {
+      case Mode::Offset:
+        return offset < m_NumberOfIdentifiers ? static_cast<IdentifierType>(offset) : InvalidIndex;
+      case Mode::Dense:
+        return offset < m_Table.size() ? m_Table[offset] : InvalidIndex;
+      default:
+      {
+        const auto it = m_Map.find(identifier);
+        return it != m_Map.end() ? it->second : InvalidIndex;
+      }
+    }
+  }
+
+  Mode
+  GetMode() const
+  {
+    return m_Mode;
+  }
+
+  SizeValueType
+  GetNumberOfIdentifiers() const
+  {
+    return m_NumberOfIdentifiers;
+  }
+
+private:
+  Mode                                                    m_Mode{ Mode::Offset };
+  IdentifierValueType                                     m_Offset{ 0 };
+  SizeValueType                                           m_NumberOfIdentifiers{ 0 };
+  std::vector<IdentifierType>                             m_Table;
+  std::unordered_map<IdentifierValueType, IdentifierType> m_Map;
+};
+
+} // end namespace itk
+
+#endif
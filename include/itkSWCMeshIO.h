@@ -20,12 +20,25 @@
 #define itkSWCMeshIO_h
 #include "IOMeshSWCExport.h"
 
+#include "itkLineCell.h"
+#include "itkPolyLineCell.h"
+#include "itkMeshConvertPixelTraits.h"
 #include "itkMeshIOBase.h"
+#include "itkSWCIdentifierIndex.h"
+#include "itkSWCMorphometrics.h"
+#include "itkSWCParsedFileCache.h"
+#include "itkSWCSegmentLocator.h"
+#include "itkSWCTopology.h"
+#include "itkSWCValidationReport.h"
+#include "itkSWCParser.h"
 #include "itkVectorContainer.h"
 
+#include <array>
 #include <fstream>
 #include <unordered_map>
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 namespace itk
 {
@@ -40,6 +53,11 @@ class SWCMeshIOEnums
 {
 public:
   /** \class SWCPointData
+   *
+   * AllAttributes exposes every per-sample column in a single read as a
+   * four component VECTOR pixel of doubles, ordered as sample identifier,
+   * type identifier, radius and parent identifier.
+   *
    * \ingroup IOMeshSWC
    */
   enum class SWCPointData : uint8_t
@@ -47,16 +65,96 @@ public:
     SampleIdentifier = 0,
     TypeIdentifier,
     Radius,
-    ParentIdentifier
+    ParentIdentifier,
+    AllAttributes
+  };
+
+  /** \class SWCSampleOrder
+   *
+   * Order of the samples handed out by a read, and of the rows written.
+   * FileOrder keeps the order of the input. DepthFirst and BreadthFirst
+   * renumber the samples in tree order from the roots, so that parents
+   * precede their children and the samples of a branch are contiguous in
+   * DepthFirst order.
+   *
+   * \ingroup IOMeshSWC
+   */
+  enum class SWCSampleOrder : uint8_t
+  {
+    FileOrder = 0,
+    DepthFirst,
+    BreadthFirst
+  };
+
+  /** \class SWCCellData
+   *
+   * Geometry of the segment of every LINE_CELL, a truncated cone between a
+   * sample and its parent. Length is the distance between the two points,
+   * Volume and LateralArea those of the cone with the radii of the samples
+   * at its ends. The geometry of a POLYLINE_CELL is the sum over its
+   * segments. AllGeometry exposes the three as a VECTOR pixel in that
+   * order. NoCellData leaves the cells without data.
+   *
+   * \ingroup IOMeshSWC
+   */
+  enum class SWCCellData : uint8_t
+  {
+    NoCellData = 0,
+    Length,
+    Volume,
+    LateralArea,
+    AllGeometry
+  };
+
+  /** \class SWCRegionBoundary
+   *
+   * Treatment of the parent links that cross the boundary of the region of
+   * interest of a read. DetachParents keeps the samples inside the region
+   * only, and the samples whose parent is outside become roots.
+   * KeepBoundarySamples also keeps the samples outside the region that are
+   * linked to a sample inside, as stubs of the segments that cross the
+   * boundary. Their own parent is -1 unless it is inside.
+   *
+   * \ingroup IOMeshSWC
+   */
+  enum class SWCRegionBoundary : uint8_t
+  {
+    DetachParents = 0,
+    KeepBoundarySamples
   };
 };
 extern IOMeshSWC_EXPORT std::ostream &
                         operator<<(std::ostream & out, const SWCMeshIOEnums::SWCPointData value);
+extern IOMeshSWC_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const SWCMeshIOEnums::SWCSampleOrder value);
+extern IOMeshSWC_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const SWCMeshIOEnums::SWCCellData value);
+extern IOMeshSWC_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const SWCMeshIOEnums::SWCRegionBoundary value);
 
 /**
  *\class SWCMeshIO
  * \brief This class defines how to read and write SWC neuron morphology files.
  *
+ * Samples are tokenized in place with SWCParser. Comment lines are collected
+ * into the header content, blank lines are skipped and a line that is not a
+ * valid seven column sample raises an exception.
+ *
+ * Files named *.swc.gz are gzip-compressed, and are decompressed as they are
+ * parsed and compressed as they are written.
+ *
+ * Parsed files are shared through SWCParsedFileCache when it is enabled.
+ *
+ * The non-const containers given to SetNativeSampleIdentifiers,
+ * SetTypeIdentifiers, SetRadii and SetNativeParentIdentifiers are shared
+ * rather than copied, like the points of an itk::PointSet, so the
+ * containers of a reader handed to a writer are not copied. The IO copies a
+ * shared container before it modifies it, and reading a file replaces the
+ * containers rather than overwriting them. A caller that keeps modifying a
+ * container it has set must set a copy instead. Const containers are copied
+ * with a single bulk copy. The overloads taking an STL vector by rvalue
+ * reference adopt its storage.
+ *
  * \ingroup IOFilters
  * \ingroup IOMeshSWC
  */
@@ -152,14 +250,29 @@ public:
   // For Python wrapping
   using ParentIdentifierType = float;
 
+  /** Sample and parent identifiers are stored as 64-bit integers. The float
+   * typed containers above are converted on access. */
+  using NativeIdentifierType = SWCIdentifierIndex::IdentifierValueType;
+  using NativeIdentifierContainerType = VectorContainer<IdentifierType, NativeIdentifierType>;
+
   using SampleIdentifierContainerType = VectorContainer<IdentifierType, SampleIdentifierType>;
   using TypeIdentifierContainerType = VectorContainer<IdentifierType, TypeIdentifierType>;
   using RadiusContainerType = VectorContainer<IdentifierType, RadiusType>;
   using ParentIdentifierContainerType = VectorContainer<IdentifierType, ParentIdentifierType>;
 
-  /** Set/Get the sample identifiers. */
+  /** Set/Get the sample identifiers. GetSampleIdentifiers converts the
+   * native identifiers into a new float container on every call, in linear
+   * time, so keep the container rather than calling it per sample. The
+   * conversion is lossy: float represents integers exactly only up to 2^24,
+   * and larger identifiers are rounded. GetNativeSampleIdentifiers returns
+   * them exactly. */
   void SetSampleIdentifiers(const SampleIdentifierContainerType *);
-  const SampleIdentifierContainerType * GetSampleIdentifiers() const;
+  SampleIdentifierContainerType::ConstPointer GetSampleIdentifiers() const;
+  void SetNativeSampleIdentifiers(const NativeIdentifierContainerType *);
+  void SetNativeSampleIdentifiers(NativeIdentifierContainerType *);
+  void SetNativeSampleIdentifiers(NativeIdentifierContainerType::STLContainerType &&);
+  const NativeIdentifierContainerType * GetNativeSampleIdentifiers() const;
+  NativeIdentifierContainerType * GetNativeSampleIdentifiers();
 
   /** Set/Get the type identifiers.
    *  0 - undefined
@@ -172,37 +285,296 @@ public:
    *  7 - glia processes
    */
   void SetTypeIdentifiers(const TypeIdentifierContainerType *);
+  void SetTypeIdentifiers(TypeIdentifierContainerType *);
+  void SetTypeIdentifiers(TypeIdentifierContainerType::STLContainerType &&);
   const TypeIdentifierContainerType * GetTypeIdentifiers() const;
+  TypeIdentifierContainerType * GetTypeIdentifiers();
 
 
   /** Set/Get the Radius in micrometers (half the node thickness). */
   void SetRadii(const RadiusContainerType *);
+  void SetRadii(RadiusContainerType *);
+  void SetRadii(RadiusContainerType::STLContainerType &&);
   const RadiusContainerType * GetRadii() const;
+  RadiusContainerType * GetRadii();
 
-  /** Set/Get the parent sample identifiers. */
+  /** Set/Get the parent sample identifiers. As for the sample identifiers,
+   * GetParentIdentifiers returns a new float container, converted from the
+   * native identifiers, in which identifiers above 2^24 are rounded. */
   void SetParentIdentifiers(const ParentIdentifierContainerType *);
-  const ParentIdentifierContainerType * GetParentIdentifiers() const;
+  ParentIdentifierContainerType::ConstPointer GetParentIdentifiers() const;
+  void SetNativeParentIdentifiers(const NativeIdentifierContainerType *);
+  void SetNativeParentIdentifiers(NativeIdentifierContainerType *);
+  void SetNativeParentIdentifiers(NativeIdentifierContainerType::STLContainerType &&);
+  const NativeIdentifierContainerType * GetNativeParentIdentifiers() const;
+  NativeIdentifierContainerType * GetNativeParentIdentifiers();
 
   /** Set/Get the content of the point data on the input/output itk::Mesh. */
   itkGetConstMacro(PointDataContent, SWCMeshIOEnums::SWCPointData);
   itkSetMacro(PointDataContent, SWCMeshIOEnums::SWCPointData);
 
+  /** Set/Get the content of the cell data on the input itk::Mesh. The
+   * segment geometry is computed by ReadMeshInformation, in double
+   * precision, right after the cells. Defaults to NoCellData. */
+  itkGetConstMacro(CellDataContent, SWCMeshIOEnums::SWCCellData);
+  itkSetMacro(CellDataContent, SWCMeshIOEnums::SWCCellData);
+
+  /** Set/Get whether ReadMeshInformation emits one POLYLINE_CELL per
+   * unbranched section, from a root or branch point to the next branch
+   * point or tip, instead of one LINE_CELL per sample with a parent. The
+   * points of a polyline run from the parent end to the child end. This
+   * divides the number of cells of an itk::Mesh by the mean section length.
+   * WriteCells accepts both kinds of cells. Defaults to false. */
+  itkSetMacro(UsePolyLineCells, bool);
+  itkGetConstMacro(UsePolyLineCells, bool);
+  itkBooleanMacro(UsePolyLineCells);
+
+  /** Set/Get the number of work units used to parse and format SWC text.
+   * With more than one, an itk::MultiThreaderBase parses the input in chunks
+   * split at line boundaries, and formats the output rows of contiguous
+   * point ranges in parallel. Results are identical to the serial paths.
+   * The work units share blocks of at most MaximumParallelBlockSize (16 MiB)
+   * of text, so the block buffers, and the per-chunk samples parsed from a
+   * block, do not grow with the number of work units. Defaults to 1. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
+  /** Set/Get the zlib compression level, from 1 (fastest) to 9 (smallest),
+   * used to write files whose name ends with .gz, or any file when
+   * UseCompression is on. Compressed files are detected and decompressed on
+   * read whatever their name. Defaults to 6. */
+  itkSetClampMacro(CompressionLevel, int, 1, 9);
+  itkGetConstMacro(CompressionLevel, int);
+
+  /** Set/Get whether ReadMeshInformation also builds the parent and child
+   * adjacency of the samples, returned by GetTopology. Defaults to false. */
+  itkSetMacro(ComputeTopology, bool);
+  itkGetConstMacro(ComputeTopology, bool);
+  itkBooleanMacro(ComputeTopology);
+
+  /** Topology of the samples read by the last ReadMeshInformation, empty
+   * unless ComputeTopology is on. */
+  const SWCTopology &
+  GetTopology() const
+  {
+    return m_Topology;
+  }
+
+  /** Set/Get the order of the samples. On read, the samples are renumbered
+   * before ReadPoints, ReadCells and ReadPointData hand them out, and
+   * GetPointPermutation maps them back to the file. On write, the rows are
+   * emitted in this order. Samples that are not reachable from a root keep
+   * their relative order after all the others. Defaults to FileOrder. */
+  itkSetMacro(SampleOrder, SWCMeshIOEnums::SWCSampleOrder);
+  itkGetConstMacro(SampleOrder, SWCMeshIOEnums::SWCSampleOrder);
+
+  /** Set/Get whether ReadMeshInformation only keeps the samples inside the
+   * axis aligned box from RegionOfInterestMinimum to RegionOfInterestMaximum,
+   * for example the current tile of a whole-brain dataset. The samples are
+   * tested as they are parsed, and the samples outside never reach the
+   * attribute containers. Parent links that leave the region are resolved
+   * as set by RegionOfInterestBoundary. Defaults to false. */
+  itkSetMacro(UseRegionOfInterest, bool);
+  itkGetConstMacro(UseRegionOfInterest, bool);
+  itkBooleanMacro(UseRegionOfInterest);
+
+  using RegionOfInterestBoundType = std::array<double, 3>;
+  itkSetMacro(RegionOfInterestMinimum, RegionOfInterestBoundType);
+  itkGetConstReferenceMacro(RegionOfInterestMinimum, RegionOfInterestBoundType);
+  itkSetMacro(RegionOfInterestMaximum, RegionOfInterestBoundType);
+  itkGetConstReferenceMacro(RegionOfInterestMaximum, RegionOfInterestBoundType);
+
+  /** Set/Get whether a sample is inside the region of interest when the
+   * sphere of its radius intersects it, rather than when its point is
+   * inside. Defaults to false. */
+  itkSetMacro(PadRegionOfInterestByRadius, bool);
+  itkGetConstMacro(PadRegionOfInterestByRadius, bool);
+  itkBooleanMacro(PadRegionOfInterestByRadius);
+
+  /** Set/Get the treatment of the parent links that cross the boundary of
+   * the region of interest. Defaults to DetachParents. */
+  itkSetMacro(RegionOfInterestBoundary, SWCMeshIOEnums::SWCRegionBoundary);
+  itkGetConstMacro(RegionOfInterestBoundary, SWCMeshIOEnums::SWCRegionBoundary);
+
+  /** Set/Get the sample identifier of the root of the subtree that
+   * ReadMeshInformation keeps, for example the first sample of one arbor.
+   * Together with SubtreeTypeIdentifiers, the samples that are, or descend
+   * from, this sample or a sample of one of these types are kept, whatever
+   * their own type. The kept samples whose parent is not kept become roots,
+   * and the kept samples are renumbered from 1 in file order, so that
+   * ReadCells, ReadPointData and the native identifiers all describe the
+   * subtree alone. The selection is made in a single pass over the parent
+   * links of the parsed samples, after the region of interest. Defaults to
+   * -1, which selects no root sample. */
+  itkSetMacro(SubtreeRootIdentifier, NativeIdentifierType);
+  itkGetConstMacro(SubtreeRootIdentifier, NativeIdentifierType);
+
+  /** Set/Get the type identifiers of the subtrees that ReadMeshInformation
+   * keeps, such as 2 for the axon, see SubtreeRootIdentifier. Defaults to
+   * empty, which selects no type. */
+  using SubtreeTypeIdentifierContainerType = std::vector<TypeIdentifierType>;
+  itkSetMacro(SubtreeTypeIdentifiers, SubtreeTypeIdentifierContainerType);
+  itkGetConstReferenceMacro(SubtreeTypeIdentifiers, SubtreeTypeIdentifierContainerType);
+
+  /** Set/Get the tolerance of the decimation of the samples on read. With a
+   * positive tolerance, ReadMeshInformation removes the samples inside the
+   * unbranched sections whose point is within the tolerance of the segment
+   * that replaces them, and whose radius is within the tolerance of the
+   * radius interpolated along it. Roots, branch points, tips and samples
+   * whose type differs from their child are kept, and the parents of the
+   * kept samples are rewritten to the nearest kept ancestor. The sections
+   * are decimated in one pass with an opening window of at most
+   * MaximumDecimationWindow samples, in linear time, after the region of
+   * interest and the subtree. Defaults to 0, which keeps every sample. */
+  itkSetMacro(DecimationTolerance, double);
+  itkGetConstMacro(DecimationTolerance, double);
+
+  /** Set/Get whether the decimation tolerance is relative to the radius of
+   * every sample, so that thick neurites are simplified more than thin
+   * ones. Defaults to false. */
+  itkSetMacro(ScaleDecimationToleranceByRadius, bool);
+  itkGetConstMacro(ScaleDecimationToleranceByRadius, bool);
+  itkBooleanMacro(ScaleDecimationToleranceByRadius);
+
+  /** Largest number of samples replaced by one segment by the decimation. */
+  static constexpr SizeValueType MaximumDecimationWindow = 64;
+
+  /** Set/Get whether ReadMeshInformation checks the parent links of the
+   * samples and fills the report returned by GetValidationReport. The check
+   * is linear in the number of samples. Defaults to false. */
+  itkSetMacro(ValidateSamples, bool);
+  itkGetConstMacro(ValidateSamples, bool);
+  itkBooleanMacro(ValidateSamples);
+
+  /** Set/Get whether ReadMeshInformation throws when ValidateSamples is on
+   * and the report is not valid. Defaults to false. */
+  itkSetMacro(ThrowOnValidationError, bool);
+  itkGetConstMacro(ThrowOnValidationError, bool);
+  itkBooleanMacro(ThrowOnValidationError);
+
+  /** Report of the last ReadMeshInformation with ValidateSamples on. The
+   * samples are checked as parsed, before the region of interest, the
+   * subtree and the decimation select from them, so the report describes the
+   * whole file. Point indices refer to the order of the samples in the
+   * file. */
+  const SWCValidationReport &
+  GetValidationReport() const
+  {
+    return m_ValidationReport;
+  }
+
+  /** Original file index of every point read by the last
+   * ReadMeshInformation. Empty when the samples are in FileOrder. */
+  const SWCTopology::IndexContainerType &
+  GetPointPermutation() const
+  {
+    return m_PointPermutation;
+  }
+
+  /** Set/Get whether ReadPoints, ReadCells and ReadPointData release the
+   * buffers they hand out, so that a read through itk::MeshFileReader does
+   * not keep a second copy of the mesh alive. ReadPointData releases all the
+   * attribute containers. Defaults to false. */
+  itkSetMacro(ReleaseBuffersAfterRead, bool);
+  itkGetConstMacro(ReleaseBuffersAfterRead, bool);
+  itkBooleanMacro(ReleaseBuffersAfterRead);
+
+  /** Set/Get the component types that ReadMeshInformation reports and that
+   * ReadPoints, ReadCells and ReadPointData write, so that a mesh with
+   * double coordinates or 64-bit point identifiers is filled without a
+   * conversion in itk::MeshFileReader. DOUBLE or LDOUBLE points are parsed
+   * in double precision. UNKNOWNCOMPONENTTYPE, the default, selects FLOAT
+   * points, UINT cells and the type in which the point and cell data are
+   * stored. */
+  itkSetMacro(RequestedPointComponentType, IOComponentEnum);
+  itkGetConstMacro(RequestedPointComponentType, IOComponentEnum);
+  itkSetMacro(RequestedCellComponentType, IOComponentEnum);
+  itkGetConstMacro(RequestedCellComponentType, IOComponentEnum);
+  itkSetMacro(RequestedPointPixelComponentType, IOComponentEnum);
+  itkGetConstMacro(RequestedPointPixelComponentType, IOComponentEnum);
+  itkSetMacro(RequestedCellPixelComponentType, IOComponentEnum);
+  itkGetConstMacro(RequestedCellPixelComponentType, IOComponentEnum);
+
+  /** Compute the morphometrics of the samples read by the last
+   * ReadMeshInformation, directly on the coordinate, radius, type and
+   * parent arrays of the IO. */
+  void
+  ComputeMorphometrics(SWCMorphometrics & morphometrics) const;
+
+  /** Build locator over the segments of the samples read by the last
+   * ReadMeshInformation, from the coordinate, radius and parent arrays of
+   * the IO. */
+  void
+  BuildSegmentLocator(SWCSegmentLocator & locator) const;
+
+  /** Release the points, cells and attributes read by ReadMeshInformation.
+   * The mesh information, topology, validation report and point permutation
+   * are kept. */
+  void
+  ReleaseBuffers();
+
+  /** Move the samples read by ReadMeshInformation into mesh, bypassing the
+   * intermediate buffers of itk::MeshFileReader, and release them.
+   *
+   * Point data whose pixel type matches its storage (int64_t identifiers,
+   * float type identifiers, double radii) is swapped into the point data
+   * container without a copy. Points whose coordinate type matches their
+   * storage, float or double with RequestedPointComponentType, are copied
+   * with a single memcpy. Other types are converted element by element.
+   * Scalar double cell data is swapped in as well. */
+  template <typename TMesh>
+  void
+  TransferToMesh(TMesh * mesh);
+
 protected:
+  /** Number of point data components in SWCPointData::AllAttributes mode. */
+  static constexpr unsigned int NumberOfAttributes = 4;
+
+  /** Number of cell data components in SWCCellData::AllGeometry mode. */
+  static constexpr unsigned int NumberOfSegmentMeasures = 3;
+
+  /** Give container an owner of its own before it is modified, if it is
+   * shared with a caller or another IO. keepValues copies the values over,
+   * otherwise the new container is empty. */
+  template <typename TContainer>
+  static void
+  MakeContainerUnique(SmartPointer<TContainer> & container, bool keepValues)
+  {
+    if (container->GetReferenceCount() > 1)
+    {
+      auto unique = TContainer::New();
+      if (keepValues)
+      {
+        unique->CastToSTLContainer() = container->CastToSTLConstContainer();
+      }
+      container = unique;
+    }
+  }
+
   /** Write points to output stream */
   template <typename T>
   void
   WritePoints(T * buffer)
   {
-    SizeValueType index = itk::NumericTraits<SizeValueType>::ZeroValue();
-    m_PointsBuffer->resize(this->GetNumberOfPoints());
-
-    for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
+    // Double coordinates are stored without rounding to float
+    const SizeValueType numberOfValues = this->m_NumberOfPoints * this->m_PointDimension;
+    if constexpr (std::is_floating_point_v<T> && sizeof(T) > sizeof(float))
     {
-      for (unsigned int jj = 0; jj < this->m_PointDimension; ++jj)
-      {
-        m_PointsBuffer->SetElement(index, static_cast<float>(buffer[index]));
-        index++;
-      }
+      m_PointsBuffer = PointsBufferContainerType::New();
+      m_DoublePointsBuffer = DoublePointsBufferContainerType::New();
+      auto & points = m_DoublePointsBuffer->CastToSTLContainer();
+      points.resize(numberOfValues);
+      std::transform(
+        buffer, buffer + numberOfValues, points.begin(), [](T value) { return static_cast<double>(value); });
+    }
+    else
+    {
+      m_DoublePointsBuffer = DoublePointsBufferContainerType::New();
+      m_PointsBuffer = PointsBufferContainerType::New();
+      auto & points = m_PointsBuffer->CastToSTLContainer();
+      points.resize(numberOfValues);
+      std::transform(
+        buffer, buffer + numberOfValues, points.begin(), [](T value) { return static_cast<float>(value); });
     }
   }
 
@@ -215,16 +587,18 @@ protected:
     {
       case SWCMeshIOEnums::SWCPointData::SampleIdentifier:
         {
+        MakeContainerUnique(m_SampleIdentifiers, false);
         m_SampleIdentifiers->resize(this->GetNumberOfPoints());
 
         for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
         {
-          m_SampleIdentifiers->SetElement(ii, static_cast<SampleIdentifierType>(buffer[ii]));
+          m_SampleIdentifiers->SetElement(ii, static_cast<NativeIdentifierType>(buffer[ii]));
         }
         }
         break;
       case SWCMeshIOEnums::SWCPointData::TypeIdentifier:
         {
+        MakeContainerUnique(m_TypeIdentifiers, false);
         m_TypeIdentifiers->resize(this->GetNumberOfPoints());
 
         for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
@@ -235,6 +609,7 @@ protected:
         break;
       case SWCMeshIOEnums::SWCPointData::Radius:
         {
+        MakeContainerUnique(m_Radii, false);
         m_Radii->resize(this->GetNumberOfPoints());
 
         for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
@@ -245,11 +620,38 @@ protected:
         break;
       case SWCMeshIOEnums::SWCPointData::ParentIdentifier:
         {
+        MakeContainerUnique(m_ParentIdentifiers, false);
+        m_ParentIdentifiers->resize(this->GetNumberOfPoints());
+
+        for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
+        {
+          m_ParentIdentifiers->SetElement(ii, static_cast<NativeIdentifierType>(buffer[ii]));
+        }
+        }
+        break;
+      case SWCMeshIOEnums::SWCPointData::AllAttributes:
+        {
+        if (this->m_NumberOfPointPixelComponents != NumberOfAttributes)
+        {
+          itkExceptionMacro("Unexpected number of point pixel components -- expected "
+                            << NumberOfAttributes << ". Found: " << this->m_NumberOfPointPixelComponents);
+        }
+        MakeContainerUnique(m_SampleIdentifiers, false);
+        MakeContainerUnique(m_TypeIdentifiers, false);
+        MakeContainerUnique(m_Radii, false);
+        MakeContainerUnique(m_ParentIdentifiers, false);
+        m_SampleIdentifiers->resize(this->GetNumberOfPoints());
+        m_TypeIdentifiers->resize(this->GetNumberOfPoints());
+        m_Radii->resize(this->GetNumberOfPoints());
         m_ParentIdentifiers->resize(this->GetNumberOfPoints());
 
         for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
         {
-          m_ParentIdentifiers->SetElement(ii, static_cast<ParentIdentifierType>(buffer[ii]));
+          const T * attributes = buffer + NumberOfAttributes * ii;
+          m_SampleIdentifiers->SetElement(ii, static_cast<NativeIdentifierType>(attributes[0]));
+          m_TypeIdentifiers->SetElement(ii, static_cast<TypeIdentifierType>(attributes[1]));
+          m_Radii->SetElement(ii, static_cast<RadiusType>(attributes[2]));
+          m_ParentIdentifiers->SetElement(ii, static_cast<NativeIdentifierType>(attributes[3]));
         }
         }
         break;
@@ -260,29 +662,40 @@ protected:
   void
   WriteCells(T * buffer)
   {
+    MakeContainerUnique(m_ParentIdentifiers, false);
     m_ParentIdentifiers->resize(this->GetNumberOfPoints());
     std::fill(m_ParentIdentifiers->begin(), m_ParentIdentifiers->end(), -1);
     SizeValueType index = itk::NumericTraits<SizeValueType>::ZeroValue();
 
+    // Every point of a polyline is the parent of the next one
     for (SizeValueType ii = 0; ii < this->m_NumberOfCells; ++ii)
     {
-      if (static_cast<uint8_t>(buffer[index]) != static_cast<uint8_t>(CommonEnums::CellGeometry::LINE_CELL))
+      const auto cellType = static_cast<uint8_t>(buffer[index]);
+      if (cellType != static_cast<uint8_t>(CommonEnums::CellGeometry::LINE_CELL) &&
+          cellType != static_cast<uint8_t>(CommonEnums::CellGeometry::POLYLINE_CELL))
       {
-        itkExceptionMacro("Unexpected cell type -- line cell expected. Found: " << buffer[index]);
+        itkExceptionMacro("Unexpected cell type -- line or polyline cell expected. Found: " << buffer[index]);
       }
       ++index;
-      if (static_cast<uint8_t>(buffer[index]) != 2)
+      const auto numberOfCellPoints = static_cast<SizeValueType>(buffer[index]);
+      if (cellType == static_cast<uint8_t>(CommonEnums::CellGeometry::LINE_CELL) ? numberOfCellPoints != 2
+                                                                                  : numberOfCellPoints < 2)
       {
-        itkExceptionMacro("Unexpected number of cell points -- expected 2. Found: " << buffer[index]);
+        itkExceptionMacro("Unexpected number of cell points -- expected 2 or more. Found: " << buffer[index]);
       }
       ++index;
-      const auto parentPoint = static_cast<IdentifierType>(buffer[index]);
-      ++index;
-      const auto samplePoint = static_cast<IdentifierType>(buffer[index]);
-      ++index;
+      for (SizeValueType jj = 1; jj < numberOfCellPoints; ++jj)
+      {
+        const auto parentPoint = static_cast<IdentifierType>(buffer[index]);
+        const auto samplePoint = static_cast<IdentifierType>(buffer[index + 1]);
+        ++index;
 
-      const auto parentIdentifier = m_PointIndexToSampleIdentifier[parentPoint];
-      m_ParentIdentifiers->SetElement(samplePoint, parentIdentifier);
+        const auto parentIdentifier = parentPoint < m_SampleIdentifiers->size()
+                                        ? m_SampleIdentifiers->GetElement(parentPoint)
+                                        : static_cast<NativeIdentifierType>(parentPoint + 1);
+        m_ParentIdentifiers->SetElement(samplePoint, parentIdentifier);
+      }
+      ++index;
     }
   }
 
@@ -293,26 +706,378 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Size of the blocks in which formatted rows are written. */
+  static constexpr SizeValueType WriteBlockSize = 1 << 20;
+
+  /** Upper bound on the text parsed or formatted at once by all the work
+   * units together. */
+  static constexpr SizeValueType MaximumParallelBlockSize = 16 << 20;
+
+  /** Upper bound on the length of a line written by FormatSample. */
+  SizeValueType
+  GetMaximumLineLength() const;
+
+  /** Format the sample at pointIndex as one SWC line with std::to_chars,
+   * using the shortest representation that round-trips, or with snprintf
+   * where floating point std::to_chars is unavailable. buffer must hold at
+   * least GetMaximumLineLength() characters. Returns the end of the line. */
+  char *
+  FormatSample(SizeValueType pointIndex, char * buffer) const;
+
+  /** Move parsed samples into the attribute containers, reorder them as
+   * requested, and update the mesh information to match.
+   * cells, if given, is a cell buffer for the samples in file order that is
+   * used instead of computing one. It must hold the line cells of the
+   * parents of the samples. */
+  void
+  UpdateMeshInformation(SWCParser::SampleBuffers & samples, std::vector<uint32_t> * cells = nullptr);
+
+  /** Check the parent links of the samples as parsed when ValidateSamples is
+   * on, and throw if requested. excludedSamples are the samples parsed
+   * outside of the region of interest, which are checked with samples in
+   * line order. */
+  void
+  ValidateParsedSamples(const SWCParser::SampleBuffers & samples, const SWCParser::SampleBuffers & excludedSamples);
+
+  /** Move samples into the attribute containers and index them. */
+  void
+  AssignSampleBuffers(SWCParser::SampleBuffers & samples);
+
+  /** Build the topology of the samples in the attribute containers, and set
+   * the mesh information to match them and the cell buffer. */
+  void
+  CompleteMeshInformation();
+
+  /** Set up samples to be tested against region as they are parsed or
+   * filtered, if UseRegionOfInterest is on. With KeepBoundarySamples, the
+   * samples outside are collected in excludedSamples, with line numbers. */
+  void
+  SetUpRegionOfInterest(SWCParser::SampleBuffers &    samples,
+                        SWCParser::SampleBuffers &    excludedSamples,
+                        SWCParser::RegionOfInterest & region) const;
+
+  /** Merge the boundary samples of excludedSamples into samples in line
+   * order, and set the parent links that leave the region to -1. */
+  void
+  ResolveRegionOfInterest(SWCParser::SampleBuffers & samples, SWCParser::SampleBuffers & excludedSamples) const;
+
+  /** Whether a subtree root sample or subtree types are set. */
+  bool
+  SelectsSubtree() const
+  {
+    return m_SubtreeRootIdentifier != -1 || !m_SubtreeTypeIdentifiers.empty();
+  }
+
+  /** Keep only the selected subtrees of samples, detach them from the
+   * samples that are removed and renumber them from 1, if SelectsSubtree. */
+  void
+  SelectSubtree(SWCParser::SampleBuffers & samples) const;
+
+  /** Remove the samples of the unbranched sections of samples that are
+   * within DecimationTolerance, if it is positive, and reconnect the kept
+   * samples. */
+  void
+  DecimateSamples(SWCParser::SampleBuffers & samples) const;
+
+  /** Parent point index of every sample, InvalidIndex for roots. Taken from
+   * the topology if it was computed, otherwise resolved into storage. */
+  const IdentifierType *
+  GetParentPointIndices(SWCTopology::IndexContainerType & storage) const;
+
+  /** Restore the mesh information of m_FileName from SWCParsedFileCache.
+   * Returns true on a cache hit. Otherwise, if the cache is enabled, key is
+   * set to the key under which AddToParsedFileCache stores the file. */
+  bool
+  ReadFromParsedFileCache(SWCParsedFileCache::KeyType & key);
+
+  /** Store the parsed content under key if the cache is enabled. */
+  void
+  AddToParsedFileCache(const SWCParsedFileCache::KeyType & key) const;
+
+  /** Name under which the files read with the current settings are stored
+   * in SWCParsedFileCache. */
+  std::string
+  GetParsedFileCacheReaderName() const;
+
+  /** Fill order with the point indices of numberOfPoints samples in
+   * m_SampleOrder, resolving parents through sampleIdentifierIndex. */
+  void
+  ComputeSampleOrder(const NativeIdentifierType *      parentIdentifiers,
+                     SizeValueType                     numberOfPoints,
+                     const SWCIdentifierIndex &        sampleIdentifierIndex,
+                     SWCTopology::IndexContainerType & order) const;
+
+  /** Replace m_CellsBuffer with the cells of numberOfPoints samples, as set
+   * by UsePolyLineCells. */
+  void
+  ComputeCellsBuffer(const NativeIdentifierType * parentIdentifiers, SizeValueType numberOfPoints);
+
+  /** Replace m_CellsBuffer with one LINE_CELL per sample whose parent is in the
+   * sample identifier index. */
+  void
+  ComputeLineCellsBuffer(const NativeIdentifierType * parentIdentifiers, SizeValueType numberOfPoints);
+
+  /** Whether cells is the buffer that ComputeLineCellsBuffer computes for
+   * the samples in the attribute containers. */
+  bool
+  IsLineCellsBuffer(const std::vector<uint32_t> & cells) const;
+
+  /** Replace m_CellsBuffer with one POLYLINE_CELL per unbranched section of the
+   * samples whose parent is in the sample identifier index. */
+  void
+  ComputePolyLineCellsBuffer(const NativeIdentifierType * parentIdentifiers, SizeValueType numberOfPoints);
+
+  /** Fill m_CellDataBuffer with the m_CellDataContent of the segments in
+   * m_CellsBuffer. */
+  void
+  ComputeCellDataBuffer();
+
+  /** Whether the points are parsed and stored in double precision. */
+  bool
+  UseDoublePrecisionPoints() const
+  {
+    return m_RequestedPointComponentType == IOComponentEnum::DOUBLE ||
+           m_RequestedPointComponentType == IOComponentEnum::LDOUBLE;
+  }
+
+  /** Whether the points of the mesh are held in m_DoublePointsBuffer rather
+   * than m_PointsBuffer. */
+  bool
+  HasDoublePrecisionPoints() const
+  {
+    return !m_DoublePointsBuffer->empty();
+  }
+
   using PointsBufferContainerType = VectorContainer<IdentifierType, float>;
+  using DoublePointsBufferContainerType = VectorContainer<IdentifierType, double>;
+  using CellDataBufferContainerType = VectorContainer<IdentifierType, double>;
   using CellsBufferContainerType = VectorContainer<IdentifierType, uint32_t>;
-  using SampleIdentifierToPointIndexType = std::unordered_map<SampleIdentifierType, IdentifierType>;
   using PointIndexToParentPointIndexType = std::unordered_map<IdentifierType, IdentifierType>;
-  using PointIndexToSampleIdentifierType = std::unordered_map<IdentifierType, SampleIdentifierType>;
 
-private:
   HeaderContentType m_HeaderContent;
-  SampleIdentifierContainerType::Pointer m_SampleIdentifiers;
+  NativeIdentifierContainerType::Pointer m_SampleIdentifiers;
   TypeIdentifierContainerType::Pointer m_TypeIdentifiers;
   RadiusContainerType::Pointer m_Radii;
-  ParentIdentifierContainerType::Pointer m_ParentIdentifiers;
+  NativeIdentifierContainerType::Pointer m_ParentIdentifiers;
   PointsBufferContainerType::Pointer m_PointsBuffer;
+  DoublePointsBufferContainerType::Pointer m_DoublePointsBuffer;
   CellsBufferContainerType::Pointer m_CellsBuffer;
-  SampleIdentifierToPointIndexType m_SampleIdentifierToPointIndex;
+  CellDataBufferContainerType::Pointer m_CellDataBuffer;
+  SWCIdentifierIndex m_SampleIdentifierIndex;
+  SWCTopology m_Topology;
+  SWCTopology::IndexContainerType m_PointPermutation;
+  SWCValidationReport m_ValidationReport;
   PointIndexToParentPointIndexType m_PointIndexToParentPointIndex;
-  PointIndexToSampleIdentifierType m_PointIndexToSampleIdentifier;
 
+private:
   SWCMeshIOEnums::SWCPointData m_PointDataContent{ SWCMeshIOEnums::SWCPointData::TypeIdentifier };
+  SWCMeshIOEnums::SWCCellData m_CellDataContent{ SWCMeshIOEnums::SWCCellData::NoCellData };
+  ThreadIdType m_NumberOfWorkUnits{ 1 };
+  int m_CompressionLevel{ 6 };
+  bool m_ComputeTopology{ false };
+  bool m_UsePolyLineCells{ false };
+  bool m_ValidateSamples{ false };
+  bool m_ThrowOnValidationError{ false };
+  bool m_ReleaseBuffersAfterRead{ false };
+  bool m_UseRegionOfInterest{ false };
+  bool m_PadRegionOfInterestByRadius{ false };
+  RegionOfInterestBoundType m_RegionOfInterestMinimum{};
+  RegionOfInterestBoundType m_RegionOfInterestMaximum{};
+  SWCMeshIOEnums::SWCRegionBoundary m_RegionOfInterestBoundary{ SWCMeshIOEnums::SWCRegionBoundary::DetachParents };
+  NativeIdentifierType m_SubtreeRootIdentifier{ -1 };
+  SubtreeTypeIdentifierContainerType m_SubtreeTypeIdentifiers;
+  double m_DecimationTolerance{ 0.0 };
+  bool m_ScaleDecimationToleranceByRadius{ false };
+  IOComponentEnum m_RequestedPointComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+  IOComponentEnum m_RequestedCellComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+  IOComponentEnum m_RequestedPointPixelComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+  IOComponentEnum m_RequestedCellPixelComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+  SWCMeshIOEnums::SWCSampleOrder m_SampleOrder{ SWCMeshIOEnums::SWCSampleOrder::FileOrder };
 };
+
+template <typename TMesh>
+void
+SWCMeshIO::TransferToMesh(TMesh * mesh)
+{
+  using PointsContainer = typename TMesh::PointsContainer;
+  using PointType = typename TMesh::PointType;
+  using CoordinateType = typename PointType::ValueType;
+  using PointDataContainer = typename TMesh::PointDataContainer;
+  using PixelType = typename TMesh::PixelType;
+  using PixelTraits = MeshConvertPixelTraits<PixelType>;
+  using ComponentType = typename PixelTraits::ComponentType;
+  using CellsContainer = typename TMesh::CellsContainer;
+  using LineCellType = LineCell<typename TMesh::CellType>;
+  using PolyLineCellType = PolyLineCell<typename TMesh::CellType>;
+  using CellDataContainer = typename TMesh::CellDataContainer;
+  using CellPixelType = typename TMesh::CellPixelType;
+  using CellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
+  using CellComponentType = typename CellPixelTraits::ComponentType;
+
+  if (TMesh::PointDimension != this->m_PointDimension)
+  {
+    itkExceptionMacro("Unexpected mesh point dimension -- expected " << this->m_PointDimension
+                                                                     << ". Found: " << TMesh::PointDimension);
+  }
+  const SizeValueType numberOfPoints = this->GetNumberOfPoints();
+  const SizeValueType numberOfCells = this->GetNumberOfCells();
+  const SizeValueType numberOfValues = numberOfPoints * this->m_PointDimension;
+  if ((m_PointsBuffer->size() != numberOfValues && m_DoublePointsBuffer->size() != numberOfValues) ||
+      m_CellsBuffer->size() != this->m_CellBufferSize || m_SampleIdentifiers->size() != numberOfPoints ||
+      m_CellDataBuffer->size() != this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents)
+  {
+    itkExceptionMacro("The buffers of " << this->m_FileName << " were released or not read");
+  }
+
+  auto points = PointsContainer::New();
+  points->Reserve(numberOfPoints);
+  auto transferPoints = [&](const auto * coordinates) {
+    using StorageType = std::decay_t<decltype(*coordinates)>;
+    if constexpr (std::is_same_v<typename PointsContainer::STLContainerType, std::vector<PointType>> &&
+                  std::is_same_v<CoordinateType, StorageType> &&
+                  sizeof(PointType) == TMesh::PointDimension * sizeof(StorageType))
+    {
+      std::memcpy(points->CastToSTLContainer().data(), coordinates, numberOfPoints * sizeof(PointType));
+    }
+    else
+    {
+      for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+      {
+        PointType point;
+        for (unsigned int jj = 0; jj < TMesh::PointDimension; ++jj)
+        {
+          point[jj] = static_cast<CoordinateType>(coordinates[ii * TMesh::PointDimension + jj]);
+        }
+        points->SetElement(ii, point);
+      }
+    }
+  };
+  if (this->HasDoublePrecisionPoints())
+  {
+    transferPoints(m_DoublePointsBuffer->CastToSTLConstContainer().data());
+  }
+  else
+  {
+    transferPoints(m_PointsBuffer->CastToSTLConstContainer().data());
+  }
+  mesh->SetPoints(points);
+
+  const unsigned int numberOfComponents = this->m_NumberOfPointPixelComponents;
+  if (PixelTraits::GetNumberOfComponents() != numberOfComponents)
+  {
+    itkExceptionMacro("Unexpected number of point pixel components -- expected "
+                      << numberOfComponents << ". Found: " << PixelTraits::GetNumberOfComponents());
+  }
+  auto pointData = PointDataContainer::New();
+  auto transferAttribute = [&](auto & container) {
+    const auto & values = container->CastToSTLConstContainer();
+    using ValueType = typename std::decay_t<decltype(values)>::value_type;
+    if constexpr (std::is_same_v<typename PointDataContainer::STLContainerType, std::vector<ValueType>>)
+    {
+      // Shared containers are copied, see SetRadii
+      MakeContainerUnique(container, true);
+      pointData->CastToSTLContainer().swap(container->CastToSTLContainer());
+    }
+    else
+    {
+      pointData->Reserve(numberOfPoints);
+      for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+      {
+        PixelType pixel;
+        PixelTraits::SetNthComponent(0, pixel, static_cast<ComponentType>(values[ii]));
+        pointData->SetElement(ii, pixel);
+      }
+    }
+  };
+  switch (m_PointDataContent)
+  {
+    case SWCMeshIOEnums::SWCPointData::SampleIdentifier:
+      transferAttribute(m_SampleIdentifiers);
+      break;
+    case SWCMeshIOEnums::SWCPointData::TypeIdentifier:
+      transferAttribute(m_TypeIdentifiers);
+      break;
+    case SWCMeshIOEnums::SWCPointData::Radius:
+      transferAttribute(m_Radii);
+      break;
+    case SWCMeshIOEnums::SWCPointData::ParentIdentifier:
+      transferAttribute(m_ParentIdentifiers);
+      break;
+    case SWCMeshIOEnums::SWCPointData::AllAttributes:
+      pointData->Reserve(numberOfPoints);
+      for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+      {
+        PixelType pixel;
+        PixelTraits::SetNthComponent(0, pixel, static_cast<ComponentType>(m_SampleIdentifiers->GetElement(ii)));
+        PixelTraits::SetNthComponent(1, pixel, static_cast<ComponentType>(m_TypeIdentifiers->GetElement(ii)));
+        PixelTraits::SetNthComponent(2, pixel, static_cast<ComponentType>(m_Radii->GetElement(ii)));
+        PixelTraits::SetNthComponent(3, pixel, static_cast<ComponentType>(m_ParentIdentifiers->GetElement(ii)));
+        pointData->SetElement(ii, pixel);
+      }
+      break;
+  }
+  mesh->SetPointData(pointData);
+
+  // The mesh takes ownership of the cells
+  auto                                         cells = CellsContainer::New();
+  const uint32_t *                             cellBuffer = m_CellsBuffer->CastToSTLConstContainer().data();
+  std::vector<typename TMesh::PointIdentifier> pointIds;
+  cells->Reserve(numberOfCells);
+  for (SizeValueType ii = 0; ii < numberOfCells; ++ii)
+  {
+    const uint32_t numberOfCellPoints = cellBuffer[1];
+    if (cellBuffer[0] == static_cast<uint32_t>(CommonEnums::CellGeometry::LINE_CELL))
+    {
+      auto * line = new LineCellType;
+      line->SetPointId(0, cellBuffer[2]);
+      line->SetPointId(1, cellBuffer[3]);
+      cells->SetElement(ii, line);
+    }
+    else
+    {
+      pointIds.assign(cellBuffer + 2, cellBuffer + 2 + numberOfCellPoints);
+      auto * polyLine = new PolyLineCellType;
+      polyLine->SetPointIds(pointIds.data(), pointIds.data() + numberOfCellPoints);
+      cells->SetElement(ii, polyLine);
+    }
+    cellBuffer += 2 + numberOfCellPoints;
+  }
+  mesh->SetCells(cells);
+
+  if (this->m_NumberOfCellPixels)
+  {
+    const unsigned int numberOfCellComponents = this->m_NumberOfCellPixelComponents;
+    if (CellPixelTraits::GetNumberOfComponents() != numberOfCellComponents)
+    {
+      itkExceptionMacro("Unexpected number of cell pixel components -- expected "
+                        << numberOfCellComponents << ". Found: " << CellPixelTraits::GetNumberOfComponents());
+    }
+    auto cellData = CellDataContainer::New();
+    if constexpr (std::is_same_v<typename CellDataContainer::STLContainerType, std::vector<double>>)
+    {
+      cellData->CastToSTLContainer().swap(m_CellDataBuffer->CastToSTLContainer());
+    }
+    else
+    {
+      const auto & values = m_CellDataBuffer->CastToSTLConstContainer();
+      cellData->Reserve(numberOfCells);
+      for (SizeValueType ii = 0; ii < numberOfCells; ++ii)
+      {
+        CellPixelType pixel;
+        for (unsigned int jj = 0; jj < numberOfCellComponents; ++jj)
+        {
+          CellPixelTraits::SetNthComponent(
+            jj, pixel, static_cast<CellComponentType>(values[ii * numberOfCellComponents + jj]));
+        }
+        cellData->SetElement(ii, pixel);
+      }
+    }
+    mesh->SetCellData(cellData);
+  }
+
+  this->ReleaseBuffers();
+}
+
 } // end namespace itk
 
 #endif
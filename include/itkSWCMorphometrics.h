@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCMorphometrics_h
+#define itkSWCMorphometrics_h
+#include "IOMeshSWCExport.h"
+
+#include "itkSWCIdentifierIndex.h"
+
+#include <array>
+#include <ostream>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ *\class SWCMorphometrics
+ * \brief Summary measures of an SWC reconstruction.
+ *
+ * Compute works on the structure of arrays held by SWCMeshIO: interleaved
+ * x, y, z coordinates, radii, type identifiers and the parent point index
+ * of every sample. Every sample that is not a root contributes the segment
+ * to its parent, a truncated cone whose length, lateral surface area and
+ * volume are summed, in total and per type identifier of the sample.
+ *
+ * The samples are processed in blocks: the measures of a block are computed
+ * in a loop without branches, in which roots are segments of length zero,
+ * then accumulated. With more than one work unit, contiguous ranges of
+ * samples are processed in parallel by an itk::MultiThreaderBase and their
+ * sums added in order, so results only depend on the number of work units.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCMorphometrics
+{
+public:
+  /** Type identifiers as stored by SWCMeshIO. */
+  using TypeIdentifierType = float;
+  using BoundType = std::array<double, 3>;
+
+  /** Parent point index of roots, as in SWCTopology. */
+  static constexpr IdentifierType InvalidIndex = SWCIdentifierIndex::InvalidIndex;
+
+  struct TypeMeasuresType
+  {
+    TypeIdentifierType TypeIdentifier;
+    SizeValueType      NumberOfSamples;
+    double             Length;
+    double             SurfaceArea;
+    double             Volume;
+  };
+  /** Measures of every type identifier, in ascending order. */
+  using TypeMeasuresContainerType = std::vector<TypeMeasuresType>;
+
+  /** Compute the measures of numberOfPoints samples. parentPointIndices
+   * holds the parent point index of every sample, InvalidIndex for roots. */
+  void
+  Compute(const float *              points,
+          const double *             radii,
+          const TypeIdentifierType * typeIdentifiers,
+          const IdentifierType *     parentPointIndices,
+          SizeValueType              numberOfPoints);
+  void
+  Compute(const double *             points,
+          const double *             radii,
+          const TypeIdentifierType * typeIdentifiers,
+          const IdentifierType *     parentPointIndices,
+          SizeValueType              numberOfPoints);
+
+  /** Reset all measures. */
+  void
+  Clear();
+
+  SizeValueType
+  GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  /** Number of samples without a parent. */
+  SizeValueType
+  GetNumberOfRoots() const
+  {
+    return m_NumberOfRoots;
+  }
+
+  /** Number of samples with two children or more. */
+  SizeValueType
+  GetNumberOfBranchPoints() const
+  {
+    return m_NumberOfBranchPoints;
+  }
+
+  /** Number of samples without children. */
+  SizeValueType
+  GetNumberOfTips() const
+  {
+    return m_NumberOfTips;
+  }
+
+  double
+  GetTotalLength() const
+  {
+    return m_TotalLength;
+  }
+
+  double
+  GetTotalSurfaceArea() const
+  {
+    return m_TotalSurfaceArea;
+  }
+
+  double
+  GetTotalVolume() const
+  {
+    return m_TotalVolume;
+  }
+
+  /** Bounding box of the sample points, empty (minimum above maximum)
+   * without samples. */
+  const BoundType &
+  GetMinimumPoint() const
+  {
+    return m_MinimumPoint;
+  }
+
+  const BoundType &
+  GetMaximumPoint() const
+  {
+    return m_MaximumPoint;
+  }
+
+  const TypeMeasuresContainerType &
+  GetTypeMeasures() const
+  {
+    return m_TypeMeasures;
+  }
+
+  /** Set/Get the number of work units. Defaults to 1. */
+  void
+  SetNumberOfWorkUnits(ThreadIdType numberOfWorkUnits)
+  {
+    m_NumberOfWorkUnits = numberOfWorkUnits > 0 ? numberOfWorkUnits : 1;
+  }
+
+  ThreadIdType
+  GetNumberOfWorkUnits() const
+  {
+    return m_NumberOfWorkUnits;
+  }
+
+  /** Write the measures, then one tab separated line per type identifier:
+   * type, number of samples, length, surface area and volume. */
+  void
+  Print(std::ostream & os) const;
+
+private:
+  template <typename TCoordinate>
+  void
+  ComputeMeasures(const TCoordinate *        points,
+                  const double *             radii,
+                  const TypeIdentifierType * typeIdentifiers,
+                  const IdentifierType *     parentPointIndices,
+                  SizeValueType              numberOfPoints);
+
+  TypeMeasuresContainerType m_TypeMeasures;
+  BoundType                 m_MinimumPoint{};
+  BoundType                 m_MaximumPoint{};
+  double                    m_TotalLength{ 0.0 };
+  double                    m_TotalSurfaceArea{ 0.0 };
+  double                    m_TotalVolume{ 0.0 };
+  SizeValueType             m_NumberOfSamples{ 0 };
+  SizeValueType             m_NumberOfRoots{ 0 };
+  SizeValueType             m_NumberOfBranchPoints{ 0 };
+  SizeValueType             m_NumberOfTips{ 0 };
+  ThreadIdType              m_NumberOfWorkUnits{ 1 };
+};
+
+} // end namespace itk
+
+#endif
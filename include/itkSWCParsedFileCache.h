@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCParsedFileCache_h
+#define itkSWCParsedFileCache_h
+#include "IOMeshSWCExport.h"
+
+#include "itkSWCParser.h"
+#include "itkVectorContainer.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace itk
+{
+
+/**
+ *\class SWCParsedFileCache
+ * \brief Process-wide LRU cache of parsed SWC files.
+ *
+ * When the cache is given a non-zero byte budget with
+ * SetMaximumSizeInBytes, every SWCMeshIO (and SWCBinaryMeshIO) looks up the
+ * file it is asked to read before parsing it, and stores what it parsed
+ * afterwards. Entries hold the header content, the per-sample arrays and the
+ * cell buffer, and are keyed by the reader class, the canonical path, the
+ * file size and the file modification time, so a file that is replaced on
+ * disk is parsed again. Modification times have a resolution of one second.
+ *
+ * The arrays of an entry are shared, without copies, with the readers that
+ * store or find it, which copy an array before they modify it. An open file
+ * is therefore held in memory once, whatever the number of readers.
+ *
+ * Least recently used entries are evicted once the budget is exceeded. The
+ * cache is disabled by default and all methods are thread-safe.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCParsedFileCache
+{
+public:
+  using HeaderContentType = std::vector<std::string>;
+
+  /** Identifies one version of a file read by one reader class. */
+  struct KeyType
+  {
+    std::string   ReaderName;
+    std::string   FileName;
+    SizeValueType FileSize{ 0 };
+    long          ModifiedTime{ 0 };
+  };
+
+  /** Parsed content of a file. The containers are those of SWCMeshIO, and
+   * are never modified once the entry is stored. Points or DoublePoints is
+   * empty, depending on the precision of the reader. PointPermutation is the
+   * original file index of every sample when the reader reordered them, and
+   * empty otherwise. */
+  struct EntryType
+  {
+    using IdentifierContainerType = VectorContainer<IdentifierType, SWCParser::IdentifierValueType>;
+    using TypeIdentifierContainerType = VectorContainer<IdentifierType, float>;
+    using PointContainerType = VectorContainer<IdentifierType, float>;
+    using DoubleContainerType = VectorContainer<IdentifierType, double>;
+    using CellContainerType = VectorContainer<IdentifierType, uint32_t>;
+
+    HeaderContentType                    HeaderContent;
+    IdentifierContainerType::Pointer     SampleIdentifiers;
+    TypeIdentifierContainerType::Pointer TypeIdentifiers;
+    PointContainerType::Pointer          Points;
+    DoubleContainerType::Pointer         DoublePoints;
+    DoubleContainerType::Pointer         Radii;
+    IdentifierContainerType::Pointer     ParentIdentifiers;
+    CellContainerType::Pointer           Cells;
+    std::vector<IdentifierType>          PointPermutation;
+
+    /** Approximate memory held by the entry. */
+    SizeValueType
+    GetSizeInBytes() const;
+  };
+  using ConstEntryPointer = std::shared_ptr<const EntryType>;
+
+  /** Return the process-wide cache. */
+  static SWCParsedFileCache &
+  GetInstance();
+
+  /** Build the key of fileName as read by readerName. Returns false if the
+   * file does not exist. */
+  static bool
+  MakeKey(const std::string & readerName, const std::string & fileName, KeyType & key);
+
+  /** Set the byte budget. Zero, the default, disables the cache. Lowering
+   * the budget evicts entries immediately. */
+  void
+  SetMaximumSizeInBytes(SizeValueType maximumSizeInBytes);
+
+  SizeValueType
+  GetMaximumSizeInBytes() const;
+
+  bool
+  IsEnabled() const
+  {
+    return this->GetMaximumSizeInBytes() > 0;
+  }
+
+  /** Return the entry stored for key, or nullptr. An entry stored for the
+   * same file with a different size or modification time is discarded. */
+  ConstEntryPointer
+  Find(const KeyType & key);
+
+  /** Store entry for key, replacing any entry for the same file. Entries
+   * larger than the whole budget are not stored. */
+  void
+  Insert(const KeyType & key, ConstEntryPointer entry);
+
+  /** Remove all entries. The statistics are kept. */
+  void
+  Clear();
+
+  SizeValueType
+  GetSizeInBytes() const;
+
+  SizeValueType
+  GetNumberOfEntries() const;
+
+  SizeValueType
+  GetNumberOfHits() const;
+
+  SizeValueType
+  GetNumberOfMisses() const;
+
+  SizeValueType
+  GetNumberOfEvictions() const;
+
+  void
+  ResetStatistics();
+
+private:
+  SWCParsedFileCache() = default;
+
+  struct ItemType
+  {
+    KeyType           Key;
+    ConstEntryPointer Entry;
+    SizeValueType     SizeInBytes;
+  };
+  using ItemListType = std::list<ItemType>;
+
+  static std::string
+  MakeLookupKey(const KeyType & key);
+
+  // Must be called with m_Mutex held
+  void
+  EvictToSize(SizeValueType sizeInBytes);
+
+  void
+  Erase(ItemListType::iterator item);
+
+  mutable std::mutex                                      m_Mutex;
+  SizeValueType                                           m_MaximumSizeInBytes{ 0 };
+  SizeValueType                                           m_SizeInBytes{ 0 };
+  ItemListType                                            m_Items;
+  std::unordered_map<std::string, ItemListType::iterator> m_Lookup;
+  SizeValueType                                           m_NumberOfHits{ 0 };
+  SizeValueType                                           m_NumberOfMisses{ 0 };
+  SizeValueType                                           m_NumberOfEvictions{ 0 };
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,602 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCParser_h
+#define itkSWCParser_h
+
+#include "itkIntTypes.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#if !defined(__cpp_lib_to_chars)
+#  include <cerrno>
+#  include <clocale>
+#  include <cstdlib>
+#  include <type_traits>
+#endif
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ *\class SWCParser
+ * \brief In-place tokenizer for SWC sample lines.
+ *
+ * An SWC sample is one line of seven whitespace separated columns: sample
+ * identifier, type identifier, x, y, z, radius and parent identifier.
+ * SWCParser reads the input in large blocks and parses the columns straight
+ * from the character data with std::from_chars, so no per-line string or
+ * stream objects are created. Standard libraries that only provide
+ * std::from_chars for integers, such as libc++, parse floating point columns
+ * with strtod and strtof instead, as in the "C" locale.
+ *
+ * LF and CRLF line endings are accepted, columns may be separated by spaces
+ * or tabs, blank lines are skipped and everything after a '#' is a comment.
+ *
+ * \ingroup IOMeshSWC
+ */
+struct SWCParser
+{
+  /** Integer type of the sample and parent identifiers. */
+  using IdentifierValueType = int64_t;
+
+  /** Size of the blocks read from the input stream. */
+  static constexpr SizeValueType DefaultBlockSize = 1 << 20;
+
+  /** Classification of a parsed line. */
+  enum class LineStatus : uint8_t
+  {
+    Empty,
+    Comment,
+    Sample,
+    Excluded,
+    Invalid
+  };
+
+  /** Axis aligned box that samples are tested against as they are parsed.
+   * With PadByRadius, a sample is inside when the sphere of its radius
+   * intersects the box, otherwise when its point is in the box. */
+  struct RegionOfInterest
+  {
+    double Minimum[3];
+    double Maximum[3];
+    bool   PadByRadius{ false };
+
+    template <typename T>
+    bool
+    Contains(const T * point, double radius) const noexcept
+    {
+      double squaredDistance = 0.0;
+      for (unsigned int jj = 0; jj < 3; ++jj)
+      {
+        const auto   coordinate = static_cast<double>(point[jj]);
+        const double difference = std::max(0.0, std::max(Minimum[jj] - coordinate, coordinate - Maximum[jj]));
+        squaredDistance += difference * difference;
+      }
+      return PadByRadius ? squaredDistance <= radius * radius : squaredDistance == 0.0;
+    }
+  };
+
+  /** Structure-of-arrays buffers that parsed samples are appended to. */
+  struct SampleBuffers
+  {
+    std::vector<IdentifierValueType> SampleIdentifiers;
+    std::vector<float>               TypeIdentifiers;
+    std::vector<float>               Points;
+    std::vector<double>              Radii;
+    std::vector<IdentifierValueType> ParentIdentifiers;
+
+    /** Coordinates parsed in double precision, filled instead of Points only
+     * when DoublePrecisionPoints is set. */
+    bool                DoublePrecisionPoints{ false };
+    std::vector<double> DoublePoints;
+
+    /** Line number of every sample, filled by ParseLines only when
+     * RecordLineNumbers is set. */
+    bool                       RecordLineNumbers{ false };
+    std::vector<SizeValueType> LineNumbers;
+
+    /** When Region is set, the samples outside it are appended to
+     * ExcludedSamples instead, or dropped without ExcludedSamples. */
+    const RegionOfInterest * Region{ nullptr };
+    SampleBuffers *          ExcludedSamples{ nullptr };
+
+    SizeValueType
+    Size() const
+    {
+      return SampleIdentifiers.size();
+    }
+
+    /** Append the samples of other. */
+    void
+    Append(const SampleBuffers & other)
+    {
+      SampleIdentifiers.insert(SampleIdentifiers.end(), other.SampleIdentifiers.begin(), other.SampleIdentifiers.end());
+      TypeIdentifiers.insert(TypeIdentifiers.end(), other.TypeIdentifiers.begin(), other.TypeIdentifiers.end());
+      Points.insert(Points.end(), other.Points.begin(), other.Points.end());
+      DoublePoints.insert(DoublePoints.end(), other.DoublePoints.begin(), other.DoublePoints.end());
+      Radii.insert(Radii.end(), other.Radii.begin(), other.Radii.end());
+      ParentIdentifiers.insert(ParentIdentifiers.end(), other.ParentIdentifiers.begin(), other.ParentIdentifiers.end());
+      LineNumbers.insert(LineNumbers.end(), other.LineNumbers.begin(), other.LineNumbers.end());
+    }
+
+    /** Keep the samples for which keep is nonzero, in order. */
+    void
+    Retain(const std::vector<uint8_t> & keep)
+    {
+      const SizeValueType numberOfSamples = Size();
+      const bool          hasLineNumbers = LineNumbers.size() == numberOfSamples;
+      SizeValueType       numberOfKeptSamples = 0;
+      for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+      {
+        if (!keep[ii])
+        {
+          continue;
+        }
+        const SizeValueType jj = numberOfKeptSamples++;
+        SampleIdentifiers[jj] = SampleIdentifiers[ii];
+        TypeIdentifiers[jj] = TypeIdentifiers[ii];
+        if (DoublePrecisionPoints)
+        {
+          std::copy_n(DoublePoints.begin() + 3 * ii, 3, DoublePoints.begin() + 3 * jj);
+        }
+        else
+        {
+          std::copy_n(Points.begin() + 3 * ii, 3, Points.begin() + 3 * jj);
+        }
+        Radii[jj] = Radii[ii];
+        ParentIdentifiers[jj] = ParentIdentifiers[ii];
+        if (hasLineNumbers)
+        {
+          LineNumbers[jj] = LineNumbers[ii];
+        }
+      }
+      SampleIdentifiers.resize(numberOfKeptSamples);
+      TypeIdentifiers.resize(numberOfKeptSamples);
+      if (DoublePrecisionPoints)
+      {
+        DoublePoints.resize(3 * numberOfKeptSamples);
+      }
+      else
+      {
+        Points.resize(3 * numberOfKeptSamples);
+      }
+      Radii.resize(numberOfKeptSamples);
+      ParentIdentifiers.resize(numberOfKeptSamples);
+      if (hasLineNumbers)
+      {
+        LineNumbers.resize(numberOfKeptSamples);
+      }
+    }
+
+    void
+    Clear()
+    {
+      SampleIdentifiers.clear();
+      TypeIdentifiers.clear();
+      Points.clear();
+      DoublePoints.clear();
+      Radii.clear();
+      ParentIdentifiers.clear();
+      LineNumbers.clear();
+    }
+  };
+
+  /** Return the end of the line starting at first, i.e. the position of the
+   * terminating '\n' or last if the line is not terminated. */
+  static const char *
+  FindLineEnd(const char * first, const char * last) noexcept
+  {
+    const auto * newline = static_cast<const char *>(std::memchr(first, '\n', static_cast<size_t>(last - first)));
+    return newline ? newline : last;
+  }
+
+  /** Parse the line [first, last), which must not contain the '\n'
+   * terminator. A sample line is appended to buffers. For a comment line,
+   * [commentFirst, commentLast) is set to the text following the '#'.
+   * A sample outside buffers.Region is Excluded. */
+  static LineStatus
+  ParseLine(const char *    first,
+            const char *    last,
+            SampleBuffers & buffers,
+            const char *&   commentFirst,
+            const char *&   commentLast)
+  {
+    if (first != last && last[-1] == '\r')
+    {
+      --last;
+    }
+    first = SkipWhitespace(first, last);
+    if (first == last)
+    {
+      return LineStatus::Empty;
+    }
+    if (*first == '#')
+    {
+      commentFirst = first + 1;
+      commentLast = last;
+      return LineStatus::Comment;
+    }
+
+    IdentifierValueType sampleIdentifier;
+    float               typeIdentifier;
+    float               point[3];
+    double              doublePoint[3];
+    double              radius;
+    IdentifierValueType parentIdentifier;
+    if (!ParseIdentifier(first, last, sampleIdentifier) || !ParseField(first, last, typeIdentifier) ||
+        !(buffers.DoublePrecisionPoints ? ParseFields(first, last, doublePoint) : ParseFields(first, last, point)) ||
+        !ParseField(first, last, radius) || !ParseIdentifier(first, last, parentIdentifier))
+    {
+      return LineStatus::Invalid;
+    }
+
+    SampleBuffers * target = &buffers;
+    if (buffers.Region && !(buffers.DoublePrecisionPoints ? buffers.Region->Contains(doublePoint, radius)
+                                                          : buffers.Region->Contains(point, radius)))
+    {
+      target = buffers.ExcludedSamples;
+      if (!target)
+      {
+        return LineStatus::Excluded;
+      }
+    }
+
+    target->SampleIdentifiers.push_back(sampleIdentifier);
+    target->TypeIdentifiers.push_back(typeIdentifier);
+    if (buffers.DoublePrecisionPoints)
+    {
+      target->DoublePoints.insert(target->DoublePoints.end(), doublePoint, doublePoint + 3);
+    }
+    else
+    {
+      target->Points.insert(target->Points.end(), point, point + 3);
+    }
+    target->Radii.push_back(radius);
+    target->ParentIdentifiers.push_back(parentIdentifier);
+    return target == &buffers ? LineStatus::Sample : LineStatus::Excluded;
+  }
+
+  /** Move the samples of buffers that are outside buffers.Region to
+   * buffers.ExcludedSamples, or drop them, as ParseLine does. Line numbers,
+   * if recorded, are the positions of the samples in buffers from 1. */
+  static void
+  FilterSamples(SampleBuffers & buffers)
+  {
+    if (!buffers.Region)
+    {
+      return;
+    }
+    SampleBuffers * excluded = buffers.ExcludedSamples;
+    if (buffers.DoublePrecisionPoints)
+    {
+      FilterSamples(buffers, buffers.DoublePoints, excluded ? &excluded->DoublePoints : nullptr);
+    }
+    else
+    {
+      FilterSamples(buffers, buffers.Points, excluded ? &excluded->Points : nullptr);
+    }
+  }
+
+  /** Parse the lines in [first, last), appending samples to buffers and the
+   * text of comment lines to comments. numberOfLines is incremented for every
+   * line visited. Parsing stops at the first invalid line, which is then the
+   * last line counted, and false is returned. */
+  static bool
+  ParseLines(const char *               first,
+             const char *               last,
+             SampleBuffers &            buffers,
+             std::vector<std::string> & comments,
+             SizeValueType &            numberOfLines)
+  {
+    while (first != last)
+    {
+      const char * lineEnd = FindLineEnd(first, last);
+      ++numberOfLines;
+      const char * commentFirst = nullptr;
+      const char * commentLast = nullptr;
+      switch (ParseLine(first, lineEnd, buffers, commentFirst, commentLast))
+      {
+        case LineStatus::Comment:
+          comments.emplace_back(commentFirst, commentLast);
+          break;
+        case LineStatus::Sample:
+          if (buffers.RecordLineNumbers)
+          {
+            buffers.LineNumbers.push_back(numberOfLines);
+          }
+          break;
+        case LineStatus::Excluded:
+          if (buffers.ExcludedSamples && buffers.ExcludedSamples->RecordLineNumbers)
+          {
+            buffers.ExcludedSamples->LineNumbers.push_back(numberOfLines);
+          }
+          break;
+        case LineStatus::Invalid:
+          return false;
+        default:
+          break;
+      }
+      first = lineEnd == last ? last : lineEnd + 1;
+    }
+    return true;
+  }
+
+  /** Split [first, last) into numberOfChunks ranges of whole lines of about
+   * equal size. chunkBoundaries receives numberOfChunks + 1 positions. */
+  static void
+  SplitAtLines(const char *               first,
+               const char *               last,
+               SizeValueType              numberOfChunks,
+               std::vector<const char *> & chunkBoundaries)
+  {
+    const auto size = static_cast<SizeValueType>(last - first);
+    chunkBoundaries.resize(numberOfChunks + 1);
+    chunkBoundaries[0] = first;
+    for (SizeValueType chunk = 1; chunk < numberOfChunks; ++chunk)
+    {
+      const char * boundary = std::max(first + chunk * size / numberOfChunks, chunkBoundaries[chunk - 1]);
+      if (boundary != first && boundary != last && boundary[-1] != '\n')
+      {
+        boundary = FindLineEnd(boundary, last);
+        boundary = boundary == last ? last : boundary + 1;
+      }
+      chunkBoundaries[chunk] = boundary;
+    }
+    chunkBoundaries[numberOfChunks] = last;
+  }
+
+  /** Read the input with read(char * destination, size_t count), which
+   * returns the number of characters read and 0 at the end of the input, and
+   * call blockFunction(first, last) on consecutive ranges of whole lines. The
+   * final range may lack a trailing '\n'. buffer is reused between calls and
+   * grows only if a single line exceeds blockSize. */
+  template <typename TReadFunction, typename TBlockFunction>
+  static void
+  ForEachBlock(TReadFunction &&    read,
+               std::vector<char> & buffer,
+               SizeValueType       blockSize,
+               TBlockFunction &&   blockFunction)
+  {
+    buffer.resize(std::max<size_t>(buffer.size(), blockSize));
+    size_t carry = 0;
+    for (;;)
+    {
+      if (carry == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      const size_t count = read(buffer.data() + carry, buffer.size() - carry);
+      const size_t filled = carry + count;
+      if (count == 0)
+      {
+        if (filled)
+        {
+          blockFunction(static_cast<const char *>(buffer.data()), static_cast<const char *>(buffer.data() + filled));
+        }
+        return;
+      }
+
+      size_t lineEnd = filled;
+      while (lineEnd > carry && buffer[lineEnd - 1] != '\n')
+      {
+        --lineEnd;
+      }
+      if (lineEnd == carry)
+      {
+        carry = filled;
+        continue;
+      }
+
+      blockFunction(static_cast<const char *>(buffer.data()), static_cast<const char *>(buffer.data() + lineEnd));
+      carry = filled - lineEnd;
+      std::memmove(buffer.data(), buffer.data() + lineEnd, carry);
+    }
+  }
+
+  /** Parse the whole input read by read, as in ForEachBlock. Returns false
+   * at the first invalid line, whose line number is then numberOfLines. */
+  template <typename TReadFunction>
+  static bool
+  ParseInput(TReadFunction &&           read,
+             std::vector<char> &        buffer,
+             SampleBuffers &            buffers,
+             std::vector<std::string> & comments,
+             SizeValueType &            numberOfLines)
+  {
+    bool isValid = true;
+    ForEachBlock(read, buffer, DefaultBlockSize, [&](const char * first, const char * last) {
+      isValid = isValid && ParseLines(first, last, buffers, comments, numberOfLines);
+    });
+    return isValid;
+  }
+
+  static const char *
+  SkipWhitespace(const char * first, const char * last) noexcept
+  {
+    while (first != last && (*first == ' ' || *first == '\t' || *first == '\r' || *first == '\v' || *first == '\f'))
+    {
+      ++first;
+    }
+    return first;
+  }
+
+  /** Parse one whitespace delimited numeric column and advance first past it. */
+  template <typename T>
+  static bool
+  ParseField(const char *& first, const char * last, T & value) noexcept
+  {
+    first = SkipWhitespace(first, last);
+    if (first != last && *first == '+')
+    {
+      ++first;
+    }
+    const auto result = FromChars(first, last, value);
+    if (result.ec != std::errc() || result.ptr == first)
+    {
+      return false;
+    }
+    first = result.ptr;
+    return first == last || *first == ' ' || *first == '\t' || *first == '\r' || *first == '#' || *first == '\v' ||
+           *first == '\f';
+  }
+
+  /** std::from_chars, with a strtod based fallback for floating point values
+   * when the standard library does not provide it. */
+  template <typename T>
+  static std::from_chars_result
+  FromChars(const char * first, const char * last, T & value) noexcept
+  {
+#if defined(__cpp_lib_to_chars)
+    return std::from_chars(first, last, value);
+#else
+    if constexpr (std::is_integral_v<T>)
+    {
+      return std::from_chars(first, last, value);
+    }
+    else
+    {
+      // Copy the number so that strtod stops at its end, with the decimal
+      // point of the current locale. Hexadecimal numbers, leading
+      // whitespace and plus signs are rejected as by std::from_chars.
+      char         number[64];
+      const char   decimalPoint = *std::localeconv()->decimal_point;
+      const char * numberLast = first;
+      size_t       length = 0;
+      for (; numberLast != last && length + 1 < sizeof(number); ++numberLast, ++length)
+      {
+        const char character = *numberLast;
+        if (character == ' ' || character == '\t' || character == '\r' || character == '\n' || character == '#' ||
+            character == '\v' || character == '\f' || character == 'x' || character == 'X')
+        {
+          break;
+        }
+        number[length] = character == '.' ? decimalPoint : character;
+      }
+      number[length] = '\0';
+      if (length == 0 || number[0] == '+' || (numberLast != last && length + 1 == sizeof(number)))
+      {
+        return { first, std::errc::invalid_argument };
+      }
+
+      char * numberEnd = nullptr;
+      errno = 0;
+      const T parsedValue = std::is_same_v<T, float> ? static_cast<T>(std::strtof(number, &numberEnd))
+                                                       : static_cast<T>(std::strtod(number, &numberEnd));
+      if (numberEnd == number)
+      {
+        return { first, std::errc::invalid_argument };
+      }
+      if (errno == ERANGE)
+      {
+        return { first + (numberEnd - number), std::errc::result_out_of_range };
+      }
+      value = parsedValue;
+      return { first + (numberEnd - number), std::errc() };
+    }
+#endif
+  }
+
+  /** Parse consecutive numeric columns into values. */
+  template <typename T, size_t VLength>
+  static bool
+  ParseFields(const char *& first, const char * last, T (&values)[VLength]) noexcept
+  {
+    for (auto & value : values)
+    {
+      if (!ParseField(first, last, value))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** Parse an identifier column. Identifiers written in floating point
+   * notation, such as "12.0", are accepted when their value is integral. */
+  static bool
+  ParseIdentifier(const char *& first, const char * last, IdentifierValueType & value) noexcept
+  {
+    const char * fieldFirst = first;
+    if (ParseField(first, last, value))
+    {
+      return true;
+    }
+    first = fieldFirst;
+    double floatingPointValue;
+    if (!ParseField(first, last, floatingPointValue) ||
+        !(floatingPointValue >= -0x1p63 && floatingPointValue < 0x1p63) ||
+        floatingPointValue != static_cast<double>(static_cast<IdentifierValueType>(floatingPointValue)))
+    {
+      return false;
+    }
+    value = static_cast<IdentifierValueType>(floatingPointValue);
+    return true;
+  }
+
+  /** FilterSamples for points of type T. */
+  template <typename T>
+  static void
+  FilterSamples(SampleBuffers & buffers, std::vector<T> & points, std::vector<T> * excludedPoints)
+  {
+    SampleBuffers *     excluded = buffers.ExcludedSamples;
+    const SizeValueType numberOfSamples = buffers.Size();
+    SizeValueType       numberOfKeptSamples = 0;
+    buffers.LineNumbers.clear();
+    for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+    {
+      if (buffers.Region->Contains(points.data() + 3 * ii, buffers.Radii[ii]))
+      {
+        const SizeValueType jj = numberOfKeptSamples++;
+        buffers.SampleIdentifiers[jj] = buffers.SampleIdentifiers[ii];
+        buffers.TypeIdentifiers[jj] = buffers.TypeIdentifiers[ii];
+        std::copy_n(points.begin() + 3 * ii, 3, points.begin() + 3 * jj);
+        buffers.Radii[jj] = buffers.Radii[ii];
+        buffers.ParentIdentifiers[jj] = buffers.ParentIdentifiers[ii];
+        if (buffers.RecordLineNumbers)
+        {
+          buffers.LineNumbers.push_back(ii + 1);
+        }
+      }
+      else if (excluded)
+      {
+        excluded->SampleIdentifiers.push_back(buffers.SampleIdentifiers[ii]);
+        excluded->TypeIdentifiers.push_back(buffers.TypeIdentifiers[ii]);
+        excludedPoints->insert(excludedPoints->end(), points.begin() + 3 * ii, points.begin() + 3 * ii + 3);
+        excluded->Radii.push_back(buffers.Radii[ii]);
+        excluded->ParentIdentifiers.push_back(buffers.ParentIdentifiers[ii]);
+        if (excluded->RecordLineNumbers)
+        {
+          excluded->LineNumbers.push_back(ii + 1);
+        }
+      }
+    }
+    buffers.SampleIdentifiers.resize(numberOfKeptSamples);
+    buffers.TypeIdentifiers.resize(numberOfKeptSamples);
+    points.resize(3 * numberOfKeptSamples);
+    buffers.Radii.resize(numberOfKeptSamples);
+    buffers.ParentIdentifiers.resize(numberOfKeptSamples);
+  }
+};
+
+} // end namespace itk
+
+#endif
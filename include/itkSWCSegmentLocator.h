@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCSegmentLocator_h
+#define itkSWCSegmentLocator_h
+#include "IOMeshSWCExport.h"
+
+#include "itkSWCIdentifierIndex.h"
+
+#include <array>
+#include <iostream>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ *\class SWCSegmentLocator
+ * \brief Bounding volume hierarchy over the segments of an SWC reconstruction.
+ *
+ * Every sample contributes the segment to its parent, a capsule whose radius
+ * is interpolated linearly from the radius of the sample to the radius of
+ * the parent. Roots contribute the sphere of their radius. The distance of a
+ * query point to a segment is its distance to the segment axis minus the
+ * radius at the closest axis point, and zero inside the segment.
+ *
+ * Segments are stored in the leaf order of a binary tree of axis aligned
+ * boxes, split at the median of the longest axis. The top of the tree is
+ * split serially; the subtrees below are built in parallel with more than
+ * one work unit. The tree does not depend on the number of work units, so
+ * Write produces the same bytes.
+ *
+ * Queries are const and may be run concurrently.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCSegmentLocator
+{
+public:
+  using PointType = std::array<double, 3>;
+
+  /** Parent point index of roots, as in SWCTopology. */
+  static constexpr IdentifierType InvalidIndex = SWCIdentifierIndex::InvalidIndex;
+
+  /** Segment of PointIndex to its parent. Parameter is the position of the
+   * closest axis point, 0 at the sample and 1 at the parent. */
+  struct QueryResultType
+  {
+    IdentifierType PointIndex;
+    double         Distance;
+    double         AxisDistance;
+    double         Parameter;
+  };
+  using QueryResultContainerType = std::vector<QueryResultType>;
+
+  /** Build the hierarchy over the segments of numberOfPoints samples.
+   * parentPointIndices holds the parent point index of every sample,
+   * InvalidIndex for roots. */
+  void
+  Build(const float *          points,
+        const double *         radii,
+        const IdentifierType * parentPointIndices,
+        SizeValueType          numberOfPoints);
+  void
+  Build(const double *         points,
+        const double *         radii,
+        const IdentifierType * parentPointIndices,
+        SizeValueType          numberOfPoints);
+
+  void
+  Clear();
+
+  SizeValueType
+  GetNumberOfSegments() const
+  {
+    return m_SegmentPointIndices.size();
+  }
+
+  SizeValueType
+  GetNumberOfNodes() const
+  {
+    return m_Nodes.size();
+  }
+
+  /** Find the segment closest to point. Ties are resolved by the axis
+   * distance, then by the point index. Returns false without segments. */
+  bool
+  FindNearestSegment(const PointType & point, QueryResultType & result) const;
+
+  /** Find the nearest segment of numberOfPoints interleaved query points,
+   * in parallel with more than one work unit. Without segments, the point
+   * index of the results is InvalidIndex. */
+  void
+  FindNearestSegments(const double * points, SizeValueType numberOfPoints, QueryResultType * results) const;
+
+  /** Fill results with the segments within distance of point, in ascending
+   * point index order. */
+  void
+  FindSegmentsWithinDistance(const PointType & point, double distance, QueryResultContainerType & results) const;
+
+  /** Set/Get the number of work units of Build and FindNearestSegments.
+   * Defaults to 1. */
+  void
+  SetNumberOfWorkUnits(ThreadIdType numberOfWorkUnits)
+  {
+    m_NumberOfWorkUnits = numberOfWorkUnits > 0 ? numberOfWorkUnits : 1;
+  }
+
+  ThreadIdType
+  GetNumberOfWorkUnits() const
+  {
+    return m_NumberOfWorkUnits;
+  }
+
+  /** Write the hierarchy in a little-endian binary layout, to be restored
+   * by Read without the samples. */
+  void
+  Write(std::ostream & os) const;
+
+  /** Read a hierarchy written by Write. Throws an ExceptionObject if the
+   * stream does not hold a valid hierarchy. */
+  void
+  Read(std::istream & is);
+
+private:
+  /** Internal nodes have a Count of zero and children First and First + 1.
+   * Leaves hold the segments [First, First + Count). */
+  struct NodeType
+  {
+    double   Minimum[3];
+    double   Maximum[3];
+    uint64_t First;
+    uint64_t Count;
+  };
+
+  template <typename TCoordinate>
+  void
+  BuildHierarchy(const TCoordinate *    points,
+                 const double *         radii,
+                 const IdentifierType * parentPointIndices,
+                 SizeValueType          numberOfPoints);
+
+  void
+  UpdateNearestSegment(const PointType & point, SizeValueType segment, QueryResultType & result) const;
+
+  QueryResultType
+  ComputeSegmentDistance(const PointType & point, SizeValueType segment) const;
+
+  std::vector<NodeType> m_Nodes;
+  // Sample and parent coordinates, then radii, of every segment in leaf order
+  std::vector<double>         m_SegmentPoints;
+  std::vector<double>         m_SegmentRadii;
+  std::vector<IdentifierType> m_SegmentPointIndices;
+  ThreadIdType                m_NumberOfWorkUnits{ 1 };
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,118 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCStreamingReader_h
+#define itkSWCStreamingReader_h
+#include "IOMeshSWCExport.h"
+
+#include "itkNumericTraits.h"
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSWCParser.h"
+
+#include <functional>
+
+namespace itk
+{
+
+/**
+ *\class SWCStreamingReader
+ * \brief Visit the samples of an SWC file without storing the whole file.
+ *
+ * SWCStreamingReader tokenizes an SWC file with the same parser as
+ * SWCMeshIO, but instead of filling containers it hands each comment line to
+ * the header line callback and the samples, in batches of at most BatchSize,
+ * to the sample batch callback. The batch buffers and the read buffer are
+ * reused for the whole file, so memory use does not depend on the size of
+ * the input. Gzip-compressed files are decompressed as they are read.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCStreamingReader : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SWCStreamingReader);
+
+  /** Standard class type aliases. */
+  using Self = SWCStreamingReader;
+  using Superclass = Object;
+  using ConstPointer = SmartPointer<const Self>;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(SWCStreamingReader);
+
+  /** Called with the text following the '#' of each comment line. */
+  using HeaderLineCallbackType = std::function<void(const std::string & headerLine)>;
+
+  /** Called with each batch of samples and the index of its first sample in
+   * the file. The batch is only valid for the duration of the call. */
+  using SampleBatchCallbackType =
+    std::function<void(const SWCParser::SampleBuffers & samples, SizeValueType firstSampleIndex)>;
+
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Set/Get the maximum number of samples passed to one callback call. */
+  itkSetClampMacro(BatchSize, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(BatchSize, SizeValueType);
+
+  void
+  SetHeaderLineCallback(HeaderLineCallbackType callback)
+  {
+    m_HeaderLineCallback = std::move(callback);
+  }
+
+  void
+  SetSampleBatchCallback(SampleBatchCallbackType callback)
+  {
+    m_SampleBatchCallback = std::move(callback);
+  }
+
+  /** Parse the file and invoke the callbacks. Throws on a line that is not
+   * a valid sample, after the samples preceding it have been visited. */
+  void
+  Update();
+
+  /** Number of samples visited by the last Update. */
+  itkGetConstMacro(NumberOfSamples, SizeValueType);
+
+  /** Number of lines read by the last Update. */
+  itkGetConstMacro(NumberOfLines, SizeValueType);
+
+protected:
+  SWCStreamingReader() = default;
+  ~SWCStreamingReader() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::string             m_FileName;
+  SizeValueType           m_BatchSize{ 4096 };
+  HeaderLineCallbackType  m_HeaderLineCallback;
+  SampleBatchCallbackType m_SampleBatchCallback;
+  SizeValueType           m_NumberOfSamples{ 0 };
+  SizeValueType           m_NumberOfLines{ 0 };
+};
+} // end namespace itk
+
+#endif
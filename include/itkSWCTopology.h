@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCTopology_h
+#define itkSWCTopology_h
+#include "IOMeshSWCExport.h"
+
+#include "itkSWCIdentifierIndex.h"
+
+namespace itk
+{
+
+/**
+ *\class SWCTopology
+ * \brief Parent and child adjacency of the samples of an SWC reconstruction.
+ *
+ * The children of every point are stored in compressed sparse row form:
+ * the children of point i are ChildPointIndices[ChildOffsets[i],
+ * ChildOffsets[i + 1]), in ascending point index order. Roots are the points
+ * whose parent is -1 or not in the file, and leaves are the points without
+ * children.
+ *
+ * DepthFirstOrder and BreadthFirstOrder visit the trees from the roots in
+ * linear time. Points on a parent cycle are not reachable from a root and are
+ * not visited.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCTopology
+{
+public:
+  using IdentifierValueType = SWCIdentifierIndex::IdentifierValueType;
+  using IndexContainerType = std::vector<IdentifierType>;
+
+  /** Parent point index of roots. */
+  static constexpr IdentifierType InvalidIndex = SWCIdentifierIndex::InvalidIndex;
+
+  /** Build the topology of numberOfPoints samples from their parent
+   * identifiers, resolved through sampleIdentifierIndex. */
+  void
+  Build(const IdentifierValueType * parentIdentifiers,
+        SizeValueType               numberOfPoints,
+        const SWCIdentifierIndex &  sampleIdentifierIndex);
+
+  void
+  Clear();
+
+  SizeValueType
+  GetNumberOfPoints() const
+  {
+    return m_ParentPointIndices.size();
+  }
+
+  /** Parent point index of every point, InvalidIndex for roots. */
+  const IndexContainerType &
+  GetParentPointIndices() const
+  {
+    return m_ParentPointIndices;
+  }
+
+  /** NumberOfPoints + 1 offsets into GetChildPointIndices(). */
+  const IndexContainerType &
+  GetChildOffsets() const
+  {
+    return m_ChildOffsets;
+  }
+
+  const IndexContainerType &
+  GetChildPointIndices() const
+  {
+    return m_ChildPointIndices;
+  }
+
+  const IndexContainerType &
+  GetRootPointIndices() const
+  {
+    return m_RootPointIndices;
+  }
+
+  const IndexContainerType &
+  GetLeafPointIndices() const
+  {
+    return m_LeafPointIndices;
+  }
+
+  SizeValueType
+  GetNumberOfChildren(IdentifierType pointIndex) const
+  {
+    return m_ChildOffsets[pointIndex + 1] - m_ChildOffsets[pointIndex];
+  }
+
+  /** Range of the children of pointIndex. */
+  const IdentifierType *
+  BeginChildren(IdentifierType pointIndex) const
+  {
+    return m_ChildPointIndices.data() + m_ChildOffsets[pointIndex];
+  }
+
+  const IdentifierType *
+  EndChildren(IdentifierType pointIndex) const
+  {
+    return m_ChildPointIndices.data() + m_ChildOffsets[pointIndex + 1];
+  }
+
+  /** Fill order with the points in depth-first preorder, visiting roots and
+   * children in ascending point index order. */
+  void
+  DepthFirstOrder(IndexContainerType & order) const;
+
+  /** Fill order with the points in breadth-first order. */
+  void
+  BreadthFirstOrder(IndexContainerType & order) const;
+
+private:
+  IndexContainerType m_ParentPointIndices;
+  IndexContainerType m_ChildOffsets;
+  IndexContainerType m_ChildPointIndices;
+  IndexContainerType m_RootPointIndices;
+  IndexContainerType m_LeafPointIndices;
+};
+
+} // end namespace itk
+
+#endif
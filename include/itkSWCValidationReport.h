@@ -0,0 +1,180 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkSWCValidationReport_h
+#define itkSWCValidationReport_h
+#include "IOMeshSWCExport.h"
+
+#include "itkSWCIdentifierIndex.h"
+
+#include <ostream>
+
+namespace itk
+{
+
+/**
+ *\class SWCValidationReport
+ * \brief Structural problems found in the samples of an SWC file.
+ *
+ * Compute checks the parent links of the samples in linear time: parents
+ * that are not in the file, sample identifiers that occur more than once,
+ * more than one root, and parent links that form a cycle. Every problem is
+ * counted, and the first MaximumNumberOfIssues are recorded with the point
+ * index, line number and identifiers of the offending sample.
+ *
+ * \ingroup IOMeshSWC
+ */
+class IOMeshSWC_EXPORT SWCValidationReport
+{
+public:
+  using IdentifierValueType = SWCIdentifierIndex::IdentifierValueType;
+
+  enum class ErrorCode : uint8_t
+  {
+    /** The parent identifier is neither -1 nor the identifier of a sample. */
+    MissingParent = 1,
+    /** The sample identifier occurs again on a later line. */
+    DuplicateIdentifier,
+    /** A root, i.e. a sample with parent -1, after the first one. */
+    MultipleRoots,
+    /** The sample is on a cycle of parent links. Reported once per cycle. */
+    Cycle
+  };
+
+  struct IssueType
+  {
+    ErrorCode           Code;
+    SizeValueType       PointIndex;
+    /** Line of the sample in the file, 0 when unknown. */
+    SizeValueType       LineNumber;
+    IdentifierValueType SampleIdentifier;
+    IdentifierValueType ParentIdentifier;
+  };
+  using IssueContainerType = std::vector<IssueType>;
+
+  /** Check numberOfPoints samples. sampleIdentifierIndex must index
+   * sampleIdentifiers. lineNumbers may be nullptr. */
+  void
+  Compute(const IdentifierValueType * sampleIdentifiers,
+          const IdentifierValueType * parentIdentifiers,
+          SizeValueType               numberOfPoints,
+          const SWCIdentifierIndex &  sampleIdentifierIndex,
+          const SizeValueType *       lineNumbers);
+
+  /** Reset all counts and issues. */
+  void
+  Clear();
+
+  bool
+  IsValid() const
+  {
+    return m_NumberOfIssues == 0;
+  }
+
+  const IssueContainerType &
+  GetIssues() const
+  {
+    return m_Issues;
+  }
+
+  /** Total number of issues, including the ones that were not recorded. */
+  SizeValueType
+  GetNumberOfIssues() const
+  {
+    return m_NumberOfIssues;
+  }
+
+  SizeValueType
+  GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  SizeValueType
+  GetNumberOfRoots() const
+  {
+    return m_NumberOfRoots;
+  }
+
+  SizeValueType
+  GetNumberOfMissingParents() const
+  {
+    return m_NumberOfMissingParents;
+  }
+
+  SizeValueType
+  GetNumberOfDuplicateIdentifiers() const
+  {
+    return m_NumberOfDuplicateIdentifiers;
+  }
+
+  SizeValueType
+  GetNumberOfCycles() const
+  {
+    return m_NumberOfCycles;
+  }
+
+  SizeValueType
+  GetNumberOfPointsOnCycles() const
+  {
+    return m_NumberOfPointsOnCycles;
+  }
+
+  /** Set/Get the maximum number of issues recorded. Defaults to 1000. */
+  void
+  SetMaximumNumberOfIssues(SizeValueType maximumNumberOfIssues)
+  {
+    m_MaximumNumberOfIssues = maximumNumberOfIssues;
+  }
+
+  SizeValueType
+  GetMaximumNumberOfIssues() const
+  {
+    return m_MaximumNumberOfIssues;
+  }
+
+  /** Write the counts, then one tab separated line per recorded issue:
+   * error code, line number, point index, sample and parent identifier. */
+  void
+  Print(std::ostream & os) const;
+
+private:
+  void
+  AddIssue(ErrorCode                   code,
+           SizeValueType               pointIndex,
+           const IdentifierValueType * sampleIdentifiers,
+           const IdentifierValueType * parentIdentifiers,
+           const SizeValueType *       lineNumbers);
+
+  IssueContainerType m_Issues;
+  SizeValueType      m_MaximumNumberOfIssues{ 1000 };
+  SizeValueType      m_NumberOfIssues{ 0 };
+  SizeValueType      m_NumberOfSamples{ 0 };
+  SizeValueType      m_NumberOfRoots{ 0 };
+  SizeValueType      m_NumberOfMissingParents{ 0 };
+  SizeValueType      m_NumberOfDuplicateIdentifiers{ 0 };
+  SizeValueType      m_NumberOfCycles{ 0 };
+  SizeValueType      m_NumberOfPointsOnCycles{ 0 };
+};
+
+extern IOMeshSWC_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const SWCValidationReport::ErrorCode value);
+
+} // end namespace itk
+
+#endif
@@ -15,6 +15,8 @@ itk_module(IOMeshSWC
   DEPENDS
     ITKCommon
     ITKIOMeshBase
+  PRIVATE_DEPENDS
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
   DESCRIPTION
@@ -22,5 +24,6 @@ itk_module(IOMeshSWC
   EXCLUDE_FROM_DEFAULT
   FACTORY_NAMES
     MeshIO::SWC
+    MeshIO::SWCBinary
   ENABLE_SHARED
 )
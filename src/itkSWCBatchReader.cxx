@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCBatchReader.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSWCFileStream.h"
+
+#include "itksys/Glob.hxx"
+
+#include <atomic>
+
+namespace itk
+{
+
+SWCBatchReader
+::SWCBatchReader()
+  : m_NumberOfWorkUnits(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+{}
+
+void
+SWCBatchReader
+::SetFileNames(const FileNamesContainer & fileNames)
+{
+  m_FileNames = fileNames;
+  this->Modified();
+}
+
+void
+SWCBatchReader
+::AddFileName(const std::string & fileName)
+{
+  m_FileNames.push_back(fileName);
+  this->Modified();
+}
+
+SizeValueType
+SWCBatchReader
+::AddFileNamesFromGlob(const std::string & pattern)
+{
+  itksys::Glob glob;
+  if (!glob.FindFiles(pattern))
+  {
+    itkExceptionMacro(<< "Invalid glob pattern " << pattern);
+  }
+  FileNamesContainer fileNames = glob.GetFiles();
+  std::sort(fileNames.begin(), fileNames.end());
+  m_FileNames.insert(m_FileNames.end(), fileNames.begin(), fileNames.end());
+  this->Modified();
+  return fileNames.size();
+}
+
+void
+SWCBatchReader
+::ReadRecord(RecordType & record, std::vector<char> & blockBuffer)
+{
+  SWCInputFileStream inputFile;
+  if (!inputFile.Open(record.FileName))
+  {
+    record.ErrorMessage = "Unable to open input file " + record.FileName;
+    return;
+  }
+
+  SizeValueType lineNumber = 0;
+  const auto    read = [&inputFile](char * destination, size_t count) { return inputFile.Read(destination, count); };
+  const bool    isValid = SWCParser::ParseInput(read, blockBuffer, record.Samples, record.HeaderContent, lineNumber);
+  inputFile.Close();
+  if (!isValid || inputFile.HasError())
+  {
+    record.ErrorMessage = inputFile.HasError()
+                            ? "Unable to decompress input file " + record.FileName
+                            : "Invalid SWC sample on line " + std::to_string(lineNumber) + " of " + record.FileName;
+    record.HeaderContent.clear();
+    record.Samples = SWCParser::SampleBuffers();
+    return;
+  }
+  record.Succeeded = true;
+}
+
+void
+SWCBatchReader
+::Update()
+{
+  const SizeValueType numberOfFiles = m_FileNames.size();
+  m_Records.clear();
+  m_Records.resize(numberOfFiles);
+  for (SizeValueType ii = 0; ii < numberOfFiles; ++ii)
+  {
+    m_Records[ii].FileName = m_FileNames[ii];
+  }
+
+  // Each work unit takes the next unparsed file until none is left, so that
+  // a few large files do not leave the other work units idle
+  const auto numberOfWorkUnits = static_cast<ThreadIdType>(std::min<SizeValueType>(m_NumberOfWorkUnits, numberOfFiles));
+  std::atomic<SizeValueType> nextFile{ 0 };
+  const auto                 parseFiles = [this, &nextFile, numberOfFiles](SizeValueType) {
+    std::vector<char> blockBuffer;
+    for (SizeValueType ii = nextFile++; ii < numberOfFiles; ii = nextFile++)
+    {
+      ReadRecord(m_Records[ii], blockBuffer);
+    }
+  };
+
+  if (numberOfWorkUnits > 1)
+  {
+    const auto multiThreader = MultiThreaderBase::New();
+    multiThreader->SetMaximumNumberOfThreads(numberOfWorkUnits);
+    multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    multiThreader->ParallelizeArray(0, numberOfWorkUnits, parseFiles, nullptr);
+  }
+  else
+  {
+    parseFiles(0);
+  }
+
+  m_NumberOfFailures = std::count_if(
+    m_Records.begin(), m_Records.end(), [](const RecordType & record) { return !record.Succeeded; });
+}
+
+void
+SWCBatchReader
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfFileNames: " << m_FileNames.size() << std::endl;
+  os << indent << "NumberOfRecords: " << m_Records.size() << std::endl;
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+  os << indent << "NumberOfFailures: " << m_NumberOfFailures << std::endl;
+}
+
+} // namespace itk
@@ -0,0 +1,429 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCBinaryMeshIO.h"
+#include "itkSWCBinaryStream.h"
+
+#include "itksys/SystemTools.hxx"
+
+#include <cstring>
+
+namespace itk
+{
+
+namespace
+{
+constexpr char     SWCBMagic[4] = { 'S', 'W', 'C', 'B' };
+constexpr uint64_t SWCBAlignment = 8;
+constexpr uint64_t SWCBHeaderSize = 48;
+// Header flag set when the points are stored as float64
+constexpr uint32_t SWCBDoublePrecisionPoints = 1;
+
+using SWCBinaryStream::AddSectionSize;
+using SWCBinaryStream::ReadValue;
+using SWCBinaryStream::WriteValue;
+
+uint64_t
+PaddingSize(uint64_t size)
+{
+  return (SWCBAlignment - size % SWCBAlignment) % SWCBAlignment;
+}
+
+void
+WritePadding(std::ostream & outputFile, uint64_t size)
+{
+  constexpr char zeros[SWCBAlignment] = {};
+  outputFile.write(zeros, static_cast<std::streamsize>(PaddingSize(size)));
+}
+
+// Write a padded array section in little-endian byte order.
+template <typename T>
+void
+WritePaddedSection(std::ostream & outputFile, const T * data, uint64_t size)
+{
+  SWCBinaryStream::WriteSection(outputFile, data, size);
+  WritePadding(outputFile, size * sizeof(T));
+}
+
+// Read a padded array section with a single bulk read.
+template <typename T>
+void
+ReadPaddedSection(std::istream & inputFile, std::vector<T> & data, uint64_t size)
+{
+  SWCBinaryStream::ReadSection(inputFile, data, size);
+  inputFile.seekg(static_cast<std::streamoff>(PaddingSize(size * sizeof(T))), std::ios::cur);
+}
+
+// Return container's data when it holds size values, otherwise a copy in
+// storage completed with defaultValue.
+template <typename TContainer, typename TValue>
+const TValue *
+CompleteSection(const TContainer * container, SizeValueType size, std::vector<TValue> & storage, TValue defaultValue)
+{
+  const auto & values = container->CastToSTLConstContainer();
+  if (values.size() == size)
+  {
+    return values.data();
+  }
+  storage.assign(size, defaultValue);
+  std::copy_n(values.begin(), std::min<SizeValueType>(values.size(), size), storage.begin());
+  return storage.data();
+}
+
+// Copy the content read by reader to writer and write it.
+void
+ConvertSWCFile(SWCMeshIO *          reader,
+               const std::string & inputFileName,
+               SWCMeshIO *          writer,
+               const std::string & outputFileName)
+{
+  reader->SetFileName(inputFileName);
+  reader->ReadMeshInformation();
+
+  // Points are copied at the precision they were read in
+  const SizeValueType numberOfValues = reader->GetNumberOfPoints() * reader->GetPointDimension();
+  const bool          hasDoublePoints = reader->GetPointComponentType() == IOComponentEnum::DOUBLE;
+  std::vector<float>  points;
+  std::vector<double> doublePoints;
+  if (hasDoublePoints)
+  {
+    doublePoints.resize(numberOfValues);
+    reader->ReadPoints(doublePoints.data());
+  }
+  else
+  {
+    points.resize(numberOfValues);
+    reader->ReadPoints(points.data());
+  }
+
+  writer->SetFileName(outputFileName);
+  writer->SetNumberOfPoints(reader->GetNumberOfPoints());
+  writer->SetPointDimension(reader->GetPointDimension());
+  writer->SetPointComponentType(hasDoublePoints ? IOComponentEnum::DOUBLE : IOComponentEnum::FLOAT);
+  writer->SetHeaderContent(reader->GetHeaderContent());
+  writer->SetNativeSampleIdentifiers(reader->GetNativeSampleIdentifiers());
+  writer->SetTypeIdentifiers(reader->GetTypeIdentifiers());
+  writer->SetRadii(reader->GetRadii());
+  writer->SetNativeParentIdentifiers(reader->GetNativeParentIdentifiers());
+  writer->WriteMeshInformation();
+  if (hasDoublePoints)
+  {
+    writer->WritePoints(static_cast<void *>(doublePoints.data()));
+  }
+  else
+  {
+    writer->WritePoints(static_cast<void *>(points.data()));
+  }
+  writer->Write();
+}
+} // namespace
+
+SWCBinaryMeshIO
+::SWCBinaryMeshIO()
+{
+  this->m_SupportedReadExtensions.clear();
+  this->m_SupportedWriteExtensions.clear();
+  this->AddSupportedReadExtension(".swcb");
+  this->AddSupportedWriteExtension(".swcb");
+
+  this->m_FileType = IOFileEnum::Binary;
+  this->m_ByteOrder = IOByteOrderEnum::LittleEndian;
+}
+
+SWCBinaryMeshIO::~SWCBinaryMeshIO() = default;
+
+bool
+SWCBinaryMeshIO
+::CanReadFile(const char * fileName)
+{
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    return false;
+  }
+
+  if (itksys::SystemTools::GetFilenameLastExtension(fileName) != ".swcb")
+  {
+    return false;
+  }
+
+  std::ifstream inputFile(fileName, std::ios::in | std::ios::binary);
+  char magic[sizeof(SWCBMagic)];
+  if (!inputFile.read(magic, sizeof(magic)) || std::memcmp(magic, SWCBMagic, sizeof(magic)) != 0)
+  {
+    return false;
+  }
+
+  return true;
+}
+
+bool
+SWCBinaryMeshIO
+::CanWriteFile(const char * fileName)
+{
+  if (itksys::SystemTools::GetFilenameLastExtension(fileName) != ".swcb")
+  {
+    return false;
+  }
+
+  return true;
+}
+
+void
+SWCBinaryMeshIO
+::ReadMeshInformation()
+{
+  SWCParsedFileCache::KeyType cacheKey;
+  if (this->ReadFromParsedFileCache(cacheKey))
+  {
+    return;
+  }
+
+  std::ifstream inputFile;
+  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
+  if (!inputFile.is_open())
+  {
+    itkExceptionMacro(<< "Unable to open input file " << this->m_FileName);
+  }
+
+  char magic[sizeof(SWCBMagic)];
+  inputFile.read(magic, sizeof(magic));
+  if (!inputFile || std::memcmp(magic, SWCBMagic, sizeof(magic)) != 0)
+  {
+    itkExceptionMacro(<< this->m_FileName << " is not an SWCB file");
+  }
+  const auto version = ReadValue<uint32_t>(inputFile);
+  if (version != FormatVersion)
+  {
+    itkExceptionMacro(<< "Unsupported SWCB version " << version << " in " << this->m_FileName);
+  }
+  const auto pointDimension = ReadValue<uint32_t>(inputFile);
+  const auto flags = ReadValue<uint32_t>(inputFile);
+  const auto numberOfSamples = ReadValue<uint64_t>(inputFile);
+  const auto numberOfCells = ReadValue<uint64_t>(inputFile);
+  const auto cellBufferSize = ReadValue<uint64_t>(inputFile);
+  const auto headerContentLength = ReadValue<uint64_t>(inputFile);
+  if (!inputFile || pointDimension != this->m_PointDimension || (flags & ~SWCBDoublePrecisionPoints) != 0 ||
+      cellBufferSize % 4 != 0 || cellBufferSize / 4 != numberOfCells)
+  {
+    itkExceptionMacro(<< "Invalid SWCB header in " << this->m_FileName);
+  }
+
+  const bool storesDoublePoints = (flags & SWCBDoublePrecisionPoints) != 0;
+
+  // The sections are sized from the header counts, so check that they fit in
+  // the file before allocating them
+  uint64_t expectedFileLength = SWCBHeaderSize;
+  const uint64_t pointSize = uint64_t{ pointDimension } * (storesDoublePoints ? sizeof(double) : sizeof(float));
+  if (!AddSectionSize(expectedFileLength, headerContentLength, sizeof(char), SWCBAlignment) ||
+      !AddSectionSize(expectedFileLength, numberOfSamples, sizeof(NativeIdentifierType), SWCBAlignment) ||
+      !AddSectionSize(expectedFileLength, numberOfSamples, sizeof(TypeIdentifierType), SWCBAlignment) ||
+      !AddSectionSize(expectedFileLength, numberOfSamples, pointSize, SWCBAlignment) ||
+      !AddSectionSize(expectedFileLength, numberOfSamples, sizeof(RadiusType), SWCBAlignment) ||
+      !AddSectionSize(expectedFileLength, numberOfSamples, sizeof(NativeIdentifierType), SWCBAlignment) ||
+      !AddSectionSize(expectedFileLength, cellBufferSize, sizeof(uint32_t), SWCBAlignment))
+  {
+    itkExceptionMacro(<< "Invalid SWCB header in " << this->m_FileName);
+  }
+  if (expectedFileLength > itksys::SystemTools::FileLength(this->m_FileName))
+  {
+    itkExceptionMacro(<< "Unexpected end of file in " << this->m_FileName);
+  }
+
+  std::vector<char> headerContent;
+  ReadPaddedSection(inputFile, headerContent, headerContentLength);
+  m_HeaderContent.clear();
+  const char * first = headerContent.data();
+  const char * last = first + headerContent.size();
+  while (first != last)
+  {
+    const char * lineEnd = SWCParser::FindLineEnd(first, last);
+    m_HeaderContent.emplace_back(first, lineEnd);
+    first = lineEnd == last ? last : lineEnd + 1;
+  }
+
+  SWCParser::SampleBuffers samples;
+  ReadPaddedSection(inputFile, samples.SampleIdentifiers, numberOfSamples);
+  ReadPaddedSection(inputFile, samples.TypeIdentifiers, numberOfSamples);
+  if (storesDoublePoints)
+  {
+    ReadPaddedSection(inputFile, samples.DoublePoints, pointDimension * numberOfSamples);
+  }
+  else
+  {
+    ReadPaddedSection(inputFile, samples.Points, pointDimension * numberOfSamples);
+  }
+  ReadPaddedSection(inputFile, samples.Radii, numberOfSamples);
+  ReadPaddedSection(inputFile, samples.ParentIdentifiers, numberOfSamples);
+  std::vector<uint32_t> cells;
+  ReadPaddedSection(inputFile, cells, cellBufferSize);
+  if (!inputFile)
+  {
+    itkExceptionMacro(<< "Unexpected end of file in " << this->m_FileName);
+  }
+  inputFile.close();
+
+  // Points are held at the precision they are stored in, or in double
+  // precision if requested. ReadPoints converts them to a requested point
+  // component type.
+  samples.DoublePrecisionPoints = storesDoublePoints || this->UseDoublePrecisionPoints();
+  if (samples.DoublePrecisionPoints && !storesDoublePoints)
+  {
+    samples.DoublePoints.assign(samples.Points.begin(), samples.Points.end());
+    samples.Points.clear();
+  }
+
+  // Validation checks the samples as stored, before any selection
+  this->ValidateParsedSamples(samples, SWCParser::SampleBuffers());
+
+  // The region of interest and the subtree are selected, and the samples
+  // decimated, from the samples as read. The stored cells then refer to
+  // samples that were removed, and are recomputed.
+  if (this->GetUseRegionOfInterest() || this->SelectsSubtree() || this->GetDecimationTolerance() > 0.0)
+  {
+    SWCParser::SampleBuffers    excludedSamples;
+    SWCParser::RegionOfInterest region;
+    this->SetUpRegionOfInterest(samples, excludedSamples, region);
+    SWCParser::FilterSamples(samples);
+    this->ResolveRegionOfInterest(samples, excludedSamples);
+    this->SelectSubtree(samples);
+    this->DecimateSamples(samples);
+    samples.LineNumbers.clear();
+    this->UpdateMeshInformation(samples);
+  }
+  else
+  {
+    // The stored cells are line cells, which UpdateMeshInformation checks
+    // against the parents
+    this->UpdateMeshInformation(samples, this->GetUsePolyLineCells() ? nullptr : &cells);
+  }
+  this->AddToParsedFileCache(cacheKey);
+}
+
+void
+SWCBinaryMeshIO
+::Write()
+{
+  if (this->m_FileName.empty())
+  {
+    itkExceptionMacro("No Input FileName");
+  }
+
+  const SizeValueType numberOfSamples = this->m_NumberOfPoints;
+  // Points are stored at the precision they were written in
+  const bool          storesDoublePoints = this->HasDoublePrecisionPoints();
+  const SizeValueType numberOfValues = storesDoublePoints ? m_DoublePointsBuffer->size() : m_PointsBuffer->size();
+  if (numberOfValues != numberOfSamples * this->m_PointDimension)
+  {
+    itkExceptionMacro("Expected " << numberOfSamples << " points. Found: " << numberOfValues / this->m_PointDimension);
+  }
+
+  // Complete missing attributes with the defaults used by SWCMeshIO
+  std::vector<NativeIdentifierType> sampleIdentifierStorage;
+  const NativeIdentifierType *      sampleIdentifiers = m_SampleIdentifiers->CastToSTLConstContainer().data();
+  if (m_SampleIdentifiers->size() != numberOfSamples)
+  {
+    sampleIdentifierStorage.resize(numberOfSamples);
+    for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+    {
+      sampleIdentifierStorage[ii] = ii < m_SampleIdentifiers->size() ? m_SampleIdentifiers->GetElement(ii)
+                                                                       : static_cast<NativeIdentifierType>(ii + 1);
+    }
+    sampleIdentifiers = sampleIdentifierStorage.data();
+  }
+  std::vector<TypeIdentifierType>   typeIdentifierStorage;
+  std::vector<RadiusType>           radiusStorage;
+  std::vector<NativeIdentifierType> parentIdentifierStorage;
+  const auto *                      typeIdentifiers =
+    CompleteSection(m_TypeIdentifiers.GetPointer(), numberOfSamples, typeIdentifierStorage, TypeIdentifierType{ 5 });
+  const auto * radii = CompleteSection(m_Radii.GetPointer(), numberOfSamples, radiusStorage, RadiusType{ 1.0 });
+  const auto * parentIdentifiers = CompleteSection(
+    m_ParentIdentifiers.GetPointer(), numberOfSamples, parentIdentifierStorage, NativeIdentifierType{ -1 });
+
+  // Prebuild the connectivity as line cells, so that reading it back is a
+  // bulk copy
+  m_SampleIdentifierIndex.Build(sampleIdentifiers, numberOfSamples);
+  this->ComputeLineCellsBuffer(parentIdentifiers, numberOfSamples);
+
+  std::string headerContent;
+  for (const auto & headerLine : m_HeaderContent)
+  {
+    headerContent += headerLine;
+    headerContent += '\n';
+  }
+
+  std::ofstream outputFile(this->m_FileName.c_str(), std::ios::out | std::ios::binary);
+  if (!outputFile.is_open())
+  {
+    itkExceptionMacro("Unable to open file\n"
+                      "outputFilename= "
+                      << this->m_FileName);
+  }
+
+  outputFile.write(SWCBMagic, sizeof(SWCBMagic));
+  WriteValue<uint32_t>(outputFile, FormatVersion);
+  WriteValue<uint32_t>(outputFile, this->m_PointDimension);
+  WriteValue<uint32_t>(outputFile, storesDoublePoints ? SWCBDoublePrecisionPoints : 0);
+  WriteValue<uint64_t>(outputFile, numberOfSamples);
+  WriteValue<uint64_t>(outputFile, m_CellsBuffer->size() / 4);
+  WriteValue<uint64_t>(outputFile, m_CellsBuffer->size());
+  WriteValue<uint64_t>(outputFile, headerContent.size());
+  WritePaddedSection(outputFile, headerContent.data(), headerContent.size());
+  WritePaddedSection(outputFile, sampleIdentifiers, numberOfSamples);
+  WritePaddedSection(outputFile, typeIdentifiers, numberOfSamples);
+  if (storesDoublePoints)
+  {
+    WritePaddedSection(outputFile, m_DoublePointsBuffer->CastToSTLConstContainer().data(), numberOfValues);
+  }
+  else
+  {
+    WritePaddedSection(outputFile, m_PointsBuffer->CastToSTLConstContainer().data(), numberOfValues);
+  }
+  WritePaddedSection(outputFile, radii, numberOfSamples);
+  WritePaddedSection(outputFile, parentIdentifiers, numberOfSamples);
+  WritePaddedSection(outputFile, m_CellsBuffer->CastToSTLConstContainer().data(), m_CellsBuffer->size());
+
+  if (!outputFile)
+  {
+    itkExceptionMacro("Failed to write file\n"
+                      "outputFilename= "
+                      << this->m_FileName);
+  }
+  outputFile.close();
+}
+
+void
+SWCBinaryMeshIO
+::ConvertSWCToSWCB(const std::string & swcFileName, const std::string & swcbFileName)
+{
+  const auto reader = SWCMeshIO::New();
+  const auto writer = SWCBinaryMeshIO::New();
+  // Coordinates parsed in double precision keep every value of the text
+  reader->SetRequestedPointComponentType(IOComponentEnum::DOUBLE);
+  ConvertSWCFile(reader, swcFileName, writer, swcbFileName);
+}
+
+void
+SWCBinaryMeshIO
+::ConvertSWCBToSWC(const std::string & swcbFileName, const std::string & swcFileName)
+{
+  const auto reader = SWCBinaryMeshIO::New();
+  const auto writer = SWCMeshIO::New();
+  ConvertSWCFile(reader, swcbFileName, writer, swcFileName);
+}
+
+} // namespace itk
@@ -0,0 +1,62 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "IOMeshSWCExport.h"
+
+#include "itkSWCBinaryMeshIOFactory.h"
+#include "itkSWCBinaryMeshIO.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+void
+SWCBinaryMeshIOFactory::PrintSelf(std::ostream &, Indent) const
+{}
+
+
+SWCBinaryMeshIOFactory ::SWCBinaryMeshIOFactory()
+{
+  this->RegisterOverride(
+    "itkMeshIOBase", "itkSWCBinaryMeshIO", "SWC Binary Mesh IO", true, CreateObjectFunction<SWCBinaryMeshIO>::New());
+}
+
+
+SWCBinaryMeshIOFactory::~SWCBinaryMeshIOFactory() = default;
+
+
+const char *
+SWCBinaryMeshIOFactory::GetITKSourceVersion() const
+{
+  return ITK_SOURCE_VERSION;
+}
+
+
+const char *
+SWCBinaryMeshIOFactory::GetDescription() const
+{
+  return "SWC Binary Mesh IO Factory, allows the loading of SWCB mesh into insight";
+}
+
+// Undocumented API used to register during static initialization.
+// DO NOT CALL DIRECTLY.
+void IOMeshSWC_EXPORT
+     SWCBinaryMeshIOFactoryRegister__Private()
+{
+  ObjectFactoryBase::RegisterInternalFactoryOnce<SWCBinaryMeshIOFactory>();
+}
+
+} // end namespace itk
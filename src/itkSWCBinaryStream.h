@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSWCBinaryStream_h
+#define itkSWCBinaryStream_h
+
+#include "itkByteSwapper.h"
+
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+namespace itk
+{
+
+/** Little-endian reading and writing of the values and array sections of
+ * the SWCB files and of the serialized SWCSegmentLocator. Internal to the
+ * IOMeshSWC library, not installed. */
+namespace SWCBinaryStream
+{
+
+template <typename T>
+void
+WriteValue(std::ostream & os, T value)
+{
+  ByteSwapper<T>::SwapFromSystemToLittleEndian(&value);
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T
+ReadValue(std::istream & is)
+{
+  T value{};
+  is.read(reinterpret_cast<char *>(&value), sizeof(T));
+  ByteSwapper<T>::SwapFromSystemToLittleEndian(&value);
+  return value;
+}
+
+/** Write size values of data in little-endian byte order. */
+template <typename T>
+void
+WriteSection(std::ostream & os, const T * data, uint64_t size)
+{
+  if (ByteSwapper<T>::SystemIsLittleEndian())
+  {
+    os.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size * sizeof(T)));
+  }
+  else
+  {
+    std::vector<T> swapped(data, data + size);
+    ByteSwapper<T>::SwapRangeFromSystemToLittleEndian(swapped.data(), size);
+    os.write(reinterpret_cast<const char *>(swapped.data()), static_cast<std::streamsize>(size * sizeof(T)));
+  }
+}
+
+/** Read size values into data with a single bulk read. size must have been
+ * checked against the length of the stream. */
+template <typename T>
+void
+ReadSection(std::istream & is, std::vector<T> & data, uint64_t size)
+{
+  data.resize(size);
+  is.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(size * sizeof(T)));
+  ByteSwapper<T>::SwapRangeFromSystemToLittleEndian(data.data(), size);
+}
+
+/** Add the size of a section of count values of valueSize bytes, padded to
+ * a multiple of alignment, to size. Return false when the sum does not fit
+ * in 64 bits. */
+inline bool
+AddSectionSize(uint64_t & size, uint64_t count, uint64_t valueSize, uint64_t alignment = 1)
+{
+  const uint64_t maximumSize = std::numeric_limits<uint64_t>::max() - alignment;
+  if (valueSize != 0 && count > maximumSize / valueSize)
+  {
+    return false;
+  }
+  const uint64_t sectionSize = count * valueSize + (alignment - count * valueSize % alignment) % alignment;
+  if (size > maximumSize - sectionSize)
+  {
+    return false;
+  }
+  size += sectionSize;
+  return true;
+}
+
+/** Number of bytes left in the stream, or the largest uint64_t when the
+ * stream cannot seek. */
+inline uint64_t
+GetRemainingLength(std::istream & is)
+{
+  const std::istream::pos_type position = is.tellg();
+  if (position == std::istream::pos_type(-1) || !is.seekg(0, std::ios::end))
+  {
+    is.clear();
+    return std::numeric_limits<uint64_t>::max();
+  }
+  const std::istream::pos_type end = is.tellg();
+  is.seekg(position);
+  return static_cast<uint64_t>(end - position);
+}
+
+} // end namespace SWCBinaryStream
+} // end namespace itk
+
+#endif
@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCFileStream.h"
+
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace itk
+{
+namespace
+{
+// gzread and gzwrite take the byte count as an unsigned int and return it as
+// an int.
+constexpr size_t MaximumGzipChunkSize = INT_MAX;
+
+// Size of the zlib input and output buffers, larger than its 8 KiB default
+// to match the blocks read by SWCParser.
+constexpr unsigned int GzipBufferSize = 1 << 17;
+} // namespace
+
+SWCInputFileStream::~SWCInputFileStream()
+{
+  this->Close();
+}
+
+bool
+SWCInputFileStream
+::Open(const std::string & fileName)
+{
+  this->Close();
+  m_HasError = false;
+  m_Stream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!m_Stream.is_open())
+  {
+    return false;
+  }
+
+  unsigned char magic[2] = { 0, 0 };
+  m_Stream.read(reinterpret_cast<char *>(magic), sizeof(magic));
+  const bool compressed = m_Stream.gcount() == sizeof(magic) && magic[0] == 0x1f && magic[1] == 0x8b;
+  if (!compressed)
+  {
+    m_Stream.clear();
+    m_Stream.seekg(0);
+    return true;
+  }
+
+  m_Stream.close();
+  m_GzFile = gzopen(fileName.c_str(), "rb");
+  if (m_GzFile == nullptr)
+  {
+    return false;
+  }
+  gzbuffer(m_GzFile, GzipBufferSize);
+  return true;
+}
+
+size_t
+SWCInputFileStream
+::Read(char * destination, size_t count)
+{
+  if (m_GzFile == nullptr)
+  {
+    m_Stream.read(destination, static_cast<std::streamsize>(count));
+    return static_cast<size_t>(m_Stream.gcount());
+  }
+
+  size_t numberOfBytes = 0;
+  while (numberOfBytes < count)
+  {
+    const auto chunkSize = static_cast<unsigned int>(std::min(count - numberOfBytes, MaximumGzipChunkSize));
+    const int  result = gzread(m_GzFile, destination + numberOfBytes, chunkSize);
+    if (result < 0)
+    {
+      m_HasError = true;
+      return 0;
+    }
+    if (result == 0)
+    {
+      // gzread returns 0 rather than -1 when the file ends inside the gzip
+      // stream, and reports Z_BUF_ERROR
+      int errorNumber = Z_OK;
+      gzerror(m_GzFile, &errorNumber);
+      m_HasError = errorNumber != Z_OK;
+      break;
+    }
+    numberOfBytes += static_cast<size_t>(result);
+  }
+  return numberOfBytes;
+}
+
+void
+SWCInputFileStream
+::Close()
+{
+  if (m_GzFile != nullptr)
+  {
+    if (gzclose_r(m_GzFile) != Z_OK)
+    {
+      m_HasError = true;
+    }
+    m_GzFile = nullptr;
+  }
+  if (m_Stream.is_open())
+  {
+    m_Stream.close();
+  }
+  m_Stream.clear();
+}
+
+SWCOutputFileStream::~SWCOutputFileStream()
+{
+  this->Close();
+}
+
+bool
+SWCOutputFileStream
+::Open(const std::string & fileName, int compressionLevel)
+{
+  this->Close();
+  if (compressionLevel == 0)
+  {
+    m_Stream.open(fileName.c_str(), std::ios::out | std::ios::binary);
+    return m_Stream.is_open();
+  }
+
+  const std::string mode = "wb" + std::to_string(std::clamp(compressionLevel, 1, 9));
+  m_GzFile = gzopen(fileName.c_str(), mode.c_str());
+  if (m_GzFile == nullptr)
+  {
+    return false;
+  }
+  gzbuffer(m_GzFile, GzipBufferSize);
+  return true;
+}
+
+bool
+SWCOutputFileStream
+::Write(const char * data, size_t count)
+{
+  if (m_GzFile == nullptr)
+  {
+    m_Stream.write(data, static_cast<std::streamsize>(count));
+    m_HasError = m_HasError || !m_Stream;
+    return !m_HasError;
+  }
+
+  while (count > 0 && !m_HasError)
+  {
+    const auto chunkSize = static_cast<unsigned int>(std::min(count, MaximumGzipChunkSize));
+    if (gzwrite(m_GzFile, data, chunkSize) != static_cast<int>(chunkSize))
+    {
+      m_HasError = true;
+    }
+    data += chunkSize;
+    count -= chunkSize;
+  }
+  return !m_HasError;
+}
+
+bool
+SWCOutputFileStream
+::Close()
+{
+  bool succeeded = !m_HasError;
+  if (m_GzFile != nullptr)
+  {
+    succeeded = gzclose(m_GzFile) == Z_OK && succeeded;
+    m_GzFile = nullptr;
+  }
+  if (m_Stream.is_open())
+  {
+    m_Stream.close();
+    succeeded = succeeded && !m_Stream.fail();
+  }
+  m_Stream.clear();
+  m_HasError = false;
+  return succeeded;
+}
+
+} // namespace itk
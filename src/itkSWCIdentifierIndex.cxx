@@ -0,0 +1,83 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCIdentifierIndex.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+void
+SWCIdentifierIndex
+::Build(const IdentifierValueType * identifiers, SizeValueType numberOfIdentifiers)
+{
+  this->Clear();
+  m_NumberOfIdentifiers = numberOfIdentifiers;
+  if (numberOfIdentifiers == 0)
+  {
+    return;
+  }
+
+  m_Offset = identifiers[0];
+  SizeValueType ii = 1;
+  while (ii < numberOfIdentifiers &&
+         static_cast<SizeValueType>(identifiers[ii]) - static_cast<SizeValueType>(m_Offset) == ii)
+  {
+    ++ii;
+  }
+  if (ii == numberOfIdentifiers)
+  {
+    m_Mode = Mode::Offset;
+    return;
+  }
+
+  const auto minmax = std::minmax_element(identifiers, identifiers + numberOfIdentifiers);
+  m_Offset = *minmax.first;
+  const SizeValueType range = static_cast<SizeValueType>(*minmax.second) - static_cast<SizeValueType>(m_Offset);
+  if (range < DenseRangeFactor * numberOfIdentifiers)
+  {
+    m_Mode = Mode::Dense;
+    m_Table.assign(range + 1, InvalidIndex);
+    for (ii = 0; ii < numberOfIdentifiers; ++ii)
+    {
+      m_Table[static_cast<SizeValueType>(identifiers[ii]) - static_cast<SizeValueType>(m_Offset)] = ii;
+    }
+    return;
+  }
+
+  m_Mode = Mode::Sparse;
+  m_Map.reserve(numberOfIdentifiers);
+  for (ii = 0; ii < numberOfIdentifiers; ++ii)
+  {
+    m_Map[identifiers[ii]] = ii;
+  }
+}
+
+void
+SWCIdentifierIndex
+::Clear()
+{
+  m_Mode = Mode::Offset;
+  m_Offset = 0;
+  m_NumberOfIdentifiers = 0;
+  m_Table.clear();
+  m_Map.clear();
+}
+
+} // namespace itk
@@ -17,9 +17,23 @@
  *=========================================================================*/
 
 #include "itkSWCMeshIO.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSWCFileStream.h"
 
 #include "itksys/SystemTools.hxx"
-#include "itkNumberToString.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#if !defined(__cpp_lib_to_chars)
+#  include <clocale>
+#  include <cstdio>
+#  include <limits>
+#endif
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 
 namespace itk
 {
@@ -38,6 +52,67 @@ operator<<(std::ostream & out, const SWCMeshIOEnums::SWCPointData value)
         return "SWCMeshIOEnums::SWCPointData::Radius";
       case SWCMeshIOEnums::SWCPointData::ParentIdentifier:
         return "SWCMeshIOEnums::SWCPointData::ParentIdentifier";
+      case SWCMeshIOEnums::SWCPointData::AllAttributes:
+        return "SWCMeshIOEnums::SWCPointData::AllAttributes";
+      default:
+        return "INVALID VALUE FOR SWCMeshIOEnums";
+
+    }
+  }();
+}
+
+std::ostream &
+operator<<(std::ostream & out, const SWCMeshIOEnums::SWCSampleOrder value)
+{
+  return out << [value] {
+    switch(value)
+    {
+      case SWCMeshIOEnums::SWCSampleOrder::FileOrder:
+        return "SWCMeshIOEnums::SWCSampleOrder::FileOrder";
+      case SWCMeshIOEnums::SWCSampleOrder::DepthFirst:
+        return "SWCMeshIOEnums::SWCSampleOrder::DepthFirst";
+      case SWCMeshIOEnums::SWCSampleOrder::BreadthFirst:
+        return "SWCMeshIOEnums::SWCSampleOrder::BreadthFirst";
+      default:
+        return "INVALID VALUE FOR SWCMeshIOEnums";
+
+    }
+  }();
+}
+
+std::ostream &
+operator<<(std::ostream & out, const SWCMeshIOEnums::SWCCellData value)
+{
+  return out << [value] {
+    switch(value)
+    {
+      case SWCMeshIOEnums::SWCCellData::NoCellData:
+        return "SWCMeshIOEnums::SWCCellData::NoCellData";
+      case SWCMeshIOEnums::SWCCellData::Length:
+        return "SWCMeshIOEnums::SWCCellData::Length";
+      case SWCMeshIOEnums::SWCCellData::Volume:
+        return "SWCMeshIOEnums::SWCCellData::Volume";
+      case SWCMeshIOEnums::SWCCellData::LateralArea:
+        return "SWCMeshIOEnums::SWCCellData::LateralArea";
+      case SWCMeshIOEnums::SWCCellData::AllGeometry:
+        return "SWCMeshIOEnums::SWCCellData::AllGeometry";
+      default:
+        return "INVALID VALUE FOR SWCMeshIOEnums";
+
+    }
+  }();
+}
+
+std::ostream &
+operator<<(std::ostream & out, const SWCMeshIOEnums::SWCRegionBoundary value)
+{
+  return out << [value] {
+    switch(value)
+    {
+      case SWCMeshIOEnums::SWCRegionBoundary::DetachParents:
+        return "SWCMeshIOEnums::SWCRegionBoundary::DetachParents";
+      case SWCMeshIOEnums::SWCRegionBoundary::KeepBoundarySamples:
+        return "SWCMeshIOEnums::SWCRegionBoundary::KeepBoundarySamples";
       default:
         return "INVALID VALUE FOR SWCMeshIOEnums";
 
@@ -45,17 +120,231 @@ operator<<(std::ostream & out, const SWCMeshIOEnums::SWCPointData value)
   }();
 }
 
+namespace
+{
+// Replace values by the tuples of numberOfComponents values at order
+template <typename T>
+void
+PermuteTuples(std::vector<T> & values, const std::vector<IdentifierType> & order, unsigned int numberOfComponents)
+{
+  std::vector<T> permutedValues(order.size() * numberOfComponents);
+  auto           output = permutedValues.begin();
+  for (const auto index : order)
+  {
+    output = std::copy_n(values.begin() + index * numberOfComponents, numberOfComponents, output);
+  }
+  values.swap(permutedValues);
+}
+
+// Copy numberOfValues values to output, converting them to its type. Values
+// that are stored in the requested type are copied in bulk.
+template <typename TInput, typename TOutput>
+void
+CopyValues(const TInput * input, SizeValueType numberOfValues, TOutput * output)
+{
+  if constexpr (std::is_same_v<TInput, TOutput>)
+  {
+    std::memcpy(output, input, numberOfValues * sizeof(TInput));
+  }
+  else
+  {
+    std::transform(input, input + numberOfValues, output, [](TInput value) { return static_cast<TOutput>(value); });
+  }
+}
+
+// Call function with buffer cast to a pointer to componentType. Returns
+// false if componentType is not a scalar type.
+template <typename TFunction>
+bool
+VisitComponentBuffer(IOComponentEnum componentType, void * buffer, TFunction && function)
+{
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+      function(static_cast<unsigned char *>(buffer));
+      return true;
+    case IOComponentEnum::CHAR:
+      function(static_cast<char *>(buffer));
+      return true;
+    case IOComponentEnum::USHORT:
+      function(static_cast<unsigned short *>(buffer));
+      return true;
+    case IOComponentEnum::SHORT:
+      function(static_cast<short *>(buffer));
+      return true;
+    case IOComponentEnum::UINT:
+      function(static_cast<unsigned int *>(buffer));
+      return true;
+    case IOComponentEnum::INT:
+      function(static_cast<int *>(buffer));
+      return true;
+    case IOComponentEnum::ULONG:
+      function(static_cast<unsigned long *>(buffer));
+      return true;
+    case IOComponentEnum::LONG:
+      function(static_cast<long *>(buffer));
+      return true;
+    case IOComponentEnum::ULONGLONG:
+      function(static_cast<unsigned long long *>(buffer));
+      return true;
+    case IOComponentEnum::LONGLONG:
+      function(static_cast<long long *>(buffer));
+      return true;
+    case IOComponentEnum::FLOAT:
+      function(static_cast<float *>(buffer));
+      return true;
+    case IOComponentEnum::DOUBLE:
+      function(static_cast<double *>(buffer));
+      return true;
+    case IOComponentEnum::LDOUBLE:
+      function(static_cast<long double *>(buffer));
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Call measure with the squared length and end radii of every segment of
+// the line and polyline cells, and the index of the cell. The measure is
+// inlined, so that the loop only branches on the content once.
+template <typename TCoordinate, typename TMeasure>
+void
+ForEachSegment(const TCoordinate * points,
+               unsigned int        pointDimension,
+               const double *      radii,
+               const uint32_t *    cells,
+               SizeValueType       numberOfCells,
+               TMeasure &&         measure)
+{
+  for (SizeValueType ii = 0; ii < numberOfCells; ++ii)
+  {
+    const uint32_t numberOfCellPoints = cells[1];
+    for (uint32_t kk = 1; kk < numberOfCellPoints; ++kk)
+    {
+      const uint32_t      parentIndex = cells[kk + 1];
+      const uint32_t      pointIndex = cells[kk + 2];
+      const TCoordinate * parentPoint = points + parentIndex * pointDimension;
+      const TCoordinate * point = points + pointIndex * pointDimension;
+      double              squaredLength = 0.0;
+      for (unsigned int jj = 0; jj < pointDimension; ++jj)
+      {
+        const double difference = static_cast<double>(point[jj]) - static_cast<double>(parentPoint[jj]);
+        squaredLength += difference * difference;
+      }
+      measure(squaredLength, radii[parentIndex], radii[pointIndex], ii);
+    }
+    cells += 2 + numberOfCellPoints;
+  }
+}
+
+// Number of cells in a buffer of cell type, point count and point indices
+SizeValueType
+CountCells(const std::vector<uint32_t> & cells)
+{
+  SizeValueType numberOfCells = 0;
+  for (SizeValueType index = 0; index + 1 < cells.size(); index += 2 + cells[index + 1])
+  {
+    ++numberOfCells;
+  }
+  return numberOfCells;
+}
+
+// Volume of a truncated cone of the given length and end radii
+inline double
+FrustumVolume(double squaredLength, double radius0, double radius1)
+{
+  return Math::pi / 3.0 * std::sqrt(squaredLength) * (radius0 * radius0 + radius0 * radius1 + radius1 * radius1);
+}
+
+// Lateral area of a truncated cone of the given length and end radii
+inline double
+FrustumLateralArea(double squaredLength, double radius0, double radius1)
+{
+  const double radiusDifference = radius0 - radius1;
+  return Math::pi * (radius0 + radius1) * std::sqrt(radiusDifference * radiusDifference + squaredLength);
+}
+
+// SWC files are read and written plain or gzip-compressed
+bool
+IsSWCFileName(const std::string & fileName)
+{
+  return itksys::SystemTools::StringEndsWith(fileName, ".swc") ||
+         itksys::SystemTools::StringEndsWith(fileName, ".swc.gz");
+}
+
+// Append the sample at index of source, with its line number, to destination
+void
+AppendSample(const SWCParser::SampleBuffers & source, SizeValueType index, SWCParser::SampleBuffers & destination)
+{
+  destination.SampleIdentifiers.push_back(source.SampleIdentifiers[index]);
+  destination.TypeIdentifiers.push_back(source.TypeIdentifiers[index]);
+  const auto appendPoint = [index](const auto & sourcePoints, auto & destinationPoints) {
+    destinationPoints.insert(
+      destinationPoints.end(), sourcePoints.begin() + 3 * index, sourcePoints.begin() + 3 * index + 3);
+  };
+  if (source.DoublePrecisionPoints)
+  {
+    appendPoint(source.DoublePoints, destination.DoublePoints);
+  }
+  else
+  {
+    appendPoint(source.Points, destination.Points);
+  }
+  destination.Radii.push_back(source.Radii[index]);
+  destination.ParentIdentifiers.push_back(source.ParentIdentifiers[index]);
+  destination.LineNumbers.push_back(source.LineNumbers[index]);
+}
+
+// Write value at first with std::to_chars and return the end of the
+// characters written. Standard libraries that only provide std::to_chars for
+// integers format floating point values with snprintf instead, using the
+// fewest significant digits that read back to the same value.
+template <typename T>
+char *
+ToChars(char * first, char * last, T value)
+{
+#if defined(__cpp_lib_to_chars)
+  return std::to_chars(first, last, value).ptr;
+#else
+  if constexpr (std::is_integral_v<T>)
+  {
+    return std::to_chars(first, last, value).ptr;
+  }
+  else
+  {
+    constexpr int maximumDigits = std::numeric_limits<T>::max_digits10;
+    const char    decimalPoint = *std::localeconv()->decimal_point;
+    int           length = 0;
+    for (int digits = std::numeric_limits<T>::digits10; digits <= maximumDigits; ++digits)
+    {
+      length = std::snprintf(first, last - first, "%.*g", digits, static_cast<double>(value));
+      std::replace(first, first + length, decimalPoint, '.');
+      T readValue{};
+      if (SWCParser::FromChars(first, first + length, readValue).ec == std::errc() && readValue == value)
+      {
+        break;
+      }
+    }
+    return first + length;
+  }
+#endif
+}
+} // namespace
+
 SWCMeshIO
 ::SWCMeshIO()
 {
   this->AddSupportedWriteExtension(".swc");
+  this->AddSupportedWriteExtension(".swc.gz");
 
-  m_SampleIdentifiers = SampleIdentifierContainerType::New();
+  m_SampleIdentifiers = NativeIdentifierContainerType::New();
   m_TypeIdentifiers = TypeIdentifierContainerType::New();
   m_Radii = RadiusContainerType::New();
-  m_ParentIdentifiers = ParentIdentifierContainerType::New();
+  m_ParentIdentifiers = NativeIdentifierContainerType::New();
   m_PointsBuffer = PointsBufferContainerType::New();
+  m_DoublePointsBuffer = DoublePointsBufferContainerType::New();
   m_CellsBuffer = CellsBufferContainerType::New();
+  m_CellDataBuffer = CellDataBufferContainerType::New();
 
   this->m_PointDimension = 3;
   this->m_FileType = IOFileEnum::ASCII;
@@ -72,109 +361,688 @@ SWCMeshIO
     return false;
   }
 
-  if (itksys::SystemTools::GetFilenameLastExtension(fileName) != ".swc")
+  return IsSWCFileName(fileName);
+}
+
+bool
+SWCMeshIO
+::CanWriteFile(const char * fileName)
+{
+  return IsSWCFileName(fileName);
+}
+
+void
+SWCMeshIO
+::ReadMeshInformation()
+{
+  SWCParsedFileCache::KeyType cacheKey;
+  if (this->ReadFromParsedFileCache(cacheKey))
   {
-    return false;
+    return;
   }
 
-  return true;
+  // Define input file stream and attach it to input file. Compressed files
+  // are decompressed as they are parsed.
+  SWCInputFileStream inputFile;
+  if (!inputFile.Open(this->m_FileName))
+  {
+    itkExceptionMacro(<< "Unable to open input file " << this->m_FileName);
+  }
+
+  m_HeaderContent.clear();
+  SWCParser::SampleBuffers    samples;
+  SWCParser::SampleBuffers    excludedSamples;
+  SWCParser::RegionOfInterest region;
+  samples.RecordLineNumbers = m_ValidateSamples;
+  samples.DoublePrecisionPoints = this->UseDoublePrecisionPoints();
+  this->SetUpRegionOfInterest(samples, excludedSamples, region);
+  SizeValueType lineNumber = 0;
+  std::vector<char> blockBuffer;
+  const auto read = [&inputFile](char * destination, size_t count) { return inputFile.Read(destination, count); };
+
+  if (m_NumberOfWorkUnits == 1)
+  {
+    if (!SWCParser::ParseInput(read, blockBuffer, samples, m_HeaderContent, lineNumber) && !inputFile.HasError())
+    {
+      itkExceptionMacro(<< "Invalid SWC sample on line " << lineNumber << " of " << this->m_FileName);
+    }
+  }
+  else
+  {
+    // Each block is split at line boundaries into one chunk per work unit.
+    // The chunks are parsed into their own buffers, then appended in order.
+    // The block size is capped, so that memory does not grow with the
+    // number of work units.
+    const auto multiThreader = MultiThreaderBase::New();
+    multiThreader->SetMaximumNumberOfThreads(m_NumberOfWorkUnits);
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+
+    const SizeValueType numberOfChunks = m_NumberOfWorkUnits;
+    std::vector<SWCParser::SampleBuffers> chunkSamples(numberOfChunks);
+    std::vector<SWCParser::SampleBuffers> chunkExcludedSamples(numberOfChunks);
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      chunkSamples[chunk].RecordLineNumbers = m_ValidateSamples;
+      chunkSamples[chunk].DoublePrecisionPoints = this->UseDoublePrecisionPoints();
+      this->SetUpRegionOfInterest(chunkSamples[chunk], chunkExcludedSamples[chunk], region);
+    }
+    std::vector<HeaderContentType> chunkComments(numberOfChunks);
+    std::vector<SizeValueType> chunkNumberOfLines(numberOfChunks);
+    std::vector<uint8_t> chunkIsValid(numberOfChunks);
+    std::vector<const char *> chunkBoundaries;
+
+    SWCParser::ForEachBlock(read,
+                            blockBuffer,
+                            std::min(4 * SWCParser::DefaultBlockSize * numberOfChunks, MaximumParallelBlockSize),
+                            [&](const char * first, const char * last) {
+      SWCParser::SplitAtLines(first, last, numberOfChunks, chunkBoundaries);
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfChunks,
+        [&](SizeValueType chunk) {
+          chunkSamples[chunk].Clear();
+          chunkExcludedSamples[chunk].Clear();
+          chunkComments[chunk].clear();
+          chunkNumberOfLines[chunk] = 0;
+          chunkIsValid[chunk] = SWCParser::ParseLines(chunkBoundaries[chunk],
+                                                      chunkBoundaries[chunk + 1],
+                                                      chunkSamples[chunk],
+                                                      chunkComments[chunk],
+                                                      chunkNumberOfLines[chunk]);
+        },
+        nullptr);
+
+      for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+      {
+        for (auto * buffers : { &chunkSamples[chunk], &chunkExcludedSamples[chunk] })
+        {
+          for (auto & chunkLineNumber : buffers->LineNumbers)
+          {
+            chunkLineNumber += lineNumber;
+          }
+        }
+        lineNumber += chunkNumberOfLines[chunk];
+        if (!chunkIsValid[chunk] && !inputFile.HasError())
+        {
+          itkExceptionMacro(<< "Invalid SWC sample on line " << lineNumber << " of " << this->m_FileName);
+        }
+        samples.Append(chunkSamples[chunk]);
+        excludedSamples.Append(chunkExcludedSamples[chunk]);
+        std::move(chunkComments[chunk].begin(), chunkComments[chunk].end(), std::back_inserter(m_HeaderContent));
+      }
+    });
+  }
+  inputFile.Close();
+  if (inputFile.HasError())
+  {
+    itkExceptionMacro(<< "Unable to decompress input file " << this->m_FileName);
+  }
+
+  this->ValidateParsedSamples(samples, excludedSamples);
+  this->ResolveRegionOfInterest(samples, excludedSamples);
+  this->SelectSubtree(samples);
+  this->DecimateSamples(samples);
+  this->UpdateMeshInformation(samples);
+  this->AddToParsedFileCache(cacheKey);
 }
 
 bool
 SWCMeshIO
-::CanWriteFile(const char * fileName)
+::ReadFromParsedFileCache(SWCParsedFileCache::KeyType & key)
 {
-  if (itksys::SystemTools::GetFilenameLastExtension(fileName) != ".swc")
+  // Validation reports line numbers, which are not cached
+  auto & cache = SWCParsedFileCache::GetInstance();
+  if (!cache.IsEnabled() || m_ValidateSamples ||
+      !SWCParsedFileCache::MakeKey(this->GetParsedFileCacheReaderName(), this->m_FileName, key))
+  {
+    key = SWCParsedFileCache::KeyType();
+    return false;
+  }
+
+  const auto entry = cache.Find(key);
+  if (!entry)
   {
     return false;
   }
 
+  // The entry holds samples that are already in m_SampleOrder. Its
+  // containers are shared, and copied before they are modified.
+  m_HeaderContent = entry->HeaderContent;
+  m_SampleIdentifiers = entry->SampleIdentifiers;
+  m_TypeIdentifiers = entry->TypeIdentifiers;
+  m_PointsBuffer = entry->Points;
+  m_DoublePointsBuffer = entry->DoublePoints;
+  m_Radii = entry->Radii;
+  m_ParentIdentifiers = entry->ParentIdentifiers;
+  m_CellsBuffer = entry->Cells;
+  m_SampleIdentifierIndex.Build(m_SampleIdentifiers->CastToSTLConstContainer().data(), m_SampleIdentifiers->size());
+  m_PointPermutation = entry->PointPermutation;
+  m_ValidationReport.Clear();
+  this->CompleteMeshInformation();
   return true;
 }
 
+std::string
+SWCMeshIO
+::GetParsedFileCacheReaderName() const
+{
+  // Reads with different settings produce different content
+  std::ostringstream readerName;
+  readerName << this->GetNameOfClass() << ' ' << static_cast<int>(m_SampleOrder) << ' '
+             << this->UseDoublePrecisionPoints() << ' ' << m_UsePolyLineCells;
+  if (m_UseRegionOfInterest)
+  {
+    readerName << std::setprecision(17);
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      readerName << ' ' << m_RegionOfInterestMinimum[jj] << ' ' << m_RegionOfInterestMaximum[jj];
+    }
+    readerName << ' ' << m_PadRegionOfInterestByRadius << ' ' << static_cast<int>(m_RegionOfInterestBoundary);
+  }
+  if (this->SelectsSubtree())
+  {
+    readerName << " subtree " << m_SubtreeRootIdentifier;
+    for (const auto typeIdentifier : m_SubtreeTypeIdentifiers)
+    {
+      readerName << ' ' << typeIdentifier;
+    }
+  }
+  if (m_DecimationTolerance > 0.0)
+  {
+    readerName << " decimation " << std::setprecision(17) << m_DecimationTolerance << ' '
+               << m_ScaleDecimationToleranceByRadius;
+  }
+  return readerName.str();
+}
+
 void
 SWCMeshIO
-::ReadMeshInformation()
+::AddToParsedFileCache(const SWCParsedFileCache::KeyType & key) const
 {
-  // Define input file stream and attach it to input file
-  std::ifstream inputFile;
-  inputFile.open(this->m_FileName.c_str(), std::ios::in);
-  if (!inputFile.is_open())
+  if (key.FileName.empty())
   {
-    itkExceptionMacro(<< "Unable to open input file " << this->m_FileName);
+    return;
   }
 
-  std::string line;
+  // The entry shares the containers, which are copied before they are
+  // modified
+  auto entry = std::make_shared<SWCParsedFileCache::EntryType>();
+  entry->HeaderContent = m_HeaderContent;
+  entry->SampleIdentifiers = m_SampleIdentifiers;
+  entry->TypeIdentifiers = m_TypeIdentifiers;
+  entry->Points = m_PointsBuffer;
+  entry->DoublePoints = m_DoublePointsBuffer;
+  entry->Radii = m_Radii;
+  entry->ParentIdentifiers = m_ParentIdentifiers;
+  entry->Cells = m_CellsBuffer;
+  entry->PointPermutation = m_PointPermutation;
+  SWCParsedFileCache::GetInstance().Insert(key, std::move(entry));
+}
 
-  m_HeaderContent.clear();
-  bool inHeader = true;
-  while (inHeader && !inputFile.eof())
+void
+SWCMeshIO
+::SetUpRegionOfInterest(SWCParser::SampleBuffers &    samples,
+                        SWCParser::SampleBuffers &    excludedSamples,
+                        SWCParser::RegionOfInterest & region) const
+{
+  if (!m_UseRegionOfInterest)
+  {
+    return;
+  }
+  for (unsigned int jj = 0; jj < 3; ++jj)
   {
-    std::getline(inputFile, line);
+    region.Minimum[jj] = m_RegionOfInterestMinimum[jj];
+    region.Maximum[jj] = m_RegionOfInterestMaximum[jj];
+  }
+  region.PadByRadius = m_PadRegionOfInterestByRadius;
+  samples.Region = &region;
 
-    const size_t first = line.find_first_of('#');
-    if (first == std::string::npos)
+  // Boundary samples are merged back in line order. Validation checks the
+  // samples outside as well.
+  if (m_RegionOfInterestBoundary == SWCMeshIOEnums::SWCRegionBoundary::KeepBoundarySamples || m_ValidateSamples)
+  {
+    samples.RecordLineNumbers = true;
+    samples.ExcludedSamples = &excludedSamples;
+    excludedSamples.RecordLineNumbers = true;
+    excludedSamples.DoublePrecisionPoints = samples.DoublePrecisionPoints;
+  }
+}
+
+void
+SWCMeshIO
+::ResolveRegionOfInterest(SWCParser::SampleBuffers & samples, SWCParser::SampleBuffers & excludedSamples) const
+{
+  if (!m_UseRegionOfInterest)
+  {
+    return;
+  }
+
+  SWCIdentifierIndex sampleIndex;
+  sampleIndex.Build(samples.SampleIdentifiers.data(), samples.Size());
+  const auto isInside = [&sampleIndex](NativeIdentifierType identifier) {
+    return identifier != -1 && sampleIndex.Find(identifier) != SWCIdentifierIndex::InvalidIndex;
+  };
+  if (m_RegionOfInterestBoundary == SWCMeshIOEnums::SWCRegionBoundary::DetachParents)
+  {
+    for (auto & parentIdentifier : samples.ParentIdentifiers)
+    {
+      parentIdentifier = isInside(parentIdentifier) ? parentIdentifier : -1;
+    }
+    return;
+  }
+
+  // The boundary samples are the parents and the children of the samples
+  // inside that are outside
+  const SizeValueType numberOfExcludedSamples = excludedSamples.Size();
+  SWCIdentifierIndex  excludedSampleIndex;
+  excludedSampleIndex.Build(excludedSamples.SampleIdentifiers.data(), numberOfExcludedSamples);
+  std::vector<uint8_t> isBoundarySample(numberOfExcludedSamples);
+  for (auto & parentIdentifier : samples.ParentIdentifiers)
+  {
+    if (parentIdentifier != -1 && !isInside(parentIdentifier))
     {
-      inHeader = false;
+      const IdentifierType excludedIndex = excludedSampleIndex.Find(parentIdentifier);
+      if (excludedIndex == SWCIdentifierIndex::InvalidIndex)
+      {
+        parentIdentifier = -1;
+      }
+      else
+      {
+        isBoundarySample[excludedIndex] = 1;
+      }
+    }
+  }
+  for (SizeValueType ii = 0; ii < numberOfExcludedSamples; ++ii)
+  {
+    auto & parentIdentifier = excludedSamples.ParentIdentifiers[ii];
+    if (isInside(parentIdentifier))
+    {
+      isBoundarySample[ii] = 1;
     }
     else
     {
-      m_HeaderContent.push_back(line.substr(first+1));
+      parentIdentifier = -1;
     }
+  }
 
+  SWCParser::SampleBuffers merged;
+  merged.DoublePrecisionPoints = samples.DoublePrecisionPoints;
+  merged.RecordLineNumbers = true;
+  SizeValueType insideIndex = 0;
+  for (SizeValueType ii = 0; ii < numberOfExcludedSamples; ++ii)
+  {
+    if (!isBoundarySample[ii])
+    {
+      continue;
+    }
+    while (insideIndex < samples.Size() && samples.LineNumbers[insideIndex] < excludedSamples.LineNumbers[ii])
+    {
+      AppendSample(samples, insideIndex++, merged);
+    }
+    AppendSample(excludedSamples, ii, merged);
   }
+  while (insideIndex < samples.Size())
+  {
+    AppendSample(samples, insideIndex++, merged);
+  }
+  std::swap(samples, merged);
+  excludedSamples.Clear();
+}
 
-  SizeValueType numberOfPoints = 0;
-  SizeValueType numberOfCells = 0;
-  m_SampleIdentifiers->clear();
-  m_TypeIdentifiers->clear();
-  m_Radii->clear();
-  m_ParentIdentifiers->clear();
-  m_PointsBuffer->clear();
-  m_CellsBuffer->clear();
-  this->m_CellBufferSize = 0;
-  m_SampleIdentifierToPointIndex.clear();
-  while (!inputFile.eof())
+void
+SWCMeshIO
+::SelectSubtree(SWCParser::SampleBuffers & samples) const
+{
+  if (!this->SelectsSubtree())
+  {
+    return;
+  }
+
+  const SizeValueType numberOfSamples = samples.Size();
+  SWCIdentifierIndex  sampleIndex;
+  sampleIndex.Build(samples.SampleIdentifiers.data(), numberOfSamples);
+  if (m_SubtreeRootIdentifier != -1 && sampleIndex.Find(m_SubtreeRootIdentifier) == SWCIdentifierIndex::InvalidIndex)
+  {
+    itkExceptionMacro(<< "Subtree root sample " << m_SubtreeRootIdentifier << " is not in " << this->m_FileName);
+  }
+  const auto isSeed = [this, &samples](SizeValueType ii) {
+    return samples.SampleIdentifiers[ii] == m_SubtreeRootIdentifier ||
+           std::find(m_SubtreeTypeIdentifiers.begin(), m_SubtreeTypeIdentifiers.end(), samples.TypeIdentifiers[ii]) !=
+             m_SubtreeTypeIdentifiers.end();
+  };
+
+  // A sample is kept if the walk up its parent links reaches a seed. Every
+  // walk stops at the first sample already decided, and all the samples on
+  // it are decided together, so each parent link is followed once. A walk
+  // that runs into itself is on a cycle without a seed.
+  constexpr uint8_t Undecided = 0;
+  constexpr uint8_t Kept = 1;
+  constexpr uint8_t Removed = 2;
+  constexpr uint8_t Visiting = 3;
+  std::vector<uint8_t>        state(numberOfSamples, Undecided);
+  std::vector<IdentifierType> parentIndices(numberOfSamples);
+  std::vector<SizeValueType>  path;
+  for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+  {
+    const NativeIdentifierType parentIdentifier = samples.ParentIdentifiers[ii];
+    parentIndices[ii] = parentIdentifier == -1 ? SWCIdentifierIndex::InvalidIndex : sampleIndex.Find(parentIdentifier);
+  }
+  for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+  {
+    IdentifierType current = ii;
+    while (current != SWCIdentifierIndex::InvalidIndex && state[current] == Undecided)
+    {
+      if (isSeed(current))
+      {
+        state[current] = Kept;
+        break;
+      }
+      state[current] = Visiting;
+      path.push_back(current);
+      current = parentIndices[current];
+    }
+    const uint8_t decision = current != SWCIdentifierIndex::InvalidIndex && state[current] == Kept ? Kept : Removed;
+    for (const auto visited : path)
+    {
+      state[visited] = decision;
+    }
+    path.clear();
+  }
+
+  // Renumber the kept samples from 1 in file order
+  std::vector<NativeIdentifierType> newIdentifiers(numberOfSamples, -1);
+  std::vector<uint8_t>              keep(numberOfSamples);
+  NativeIdentifierType              numberOfKeptSamples = 0;
+  for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+  {
+    keep[ii] = state[ii] == Kept;
+    if (keep[ii])
+    {
+      newIdentifiers[ii] = ++numberOfKeptSamples;
+    }
+  }
+  for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
   {
-    std::istringstream istrm(line);
+    samples.SampleIdentifiers[ii] = newIdentifiers[ii];
+    samples.ParentIdentifiers[ii] =
+      parentIndices[ii] == SWCIdentifierIndex::InvalidIndex ? -1 : newIdentifiers[parentIndices[ii]];
+  }
+  samples.Retain(keep);
+}
 
-    SampleIdentifierType sampleIdentifier;
-    istrm >> sampleIdentifier;
-    m_SampleIdentifiers->push_back(sampleIdentifier);
-    m_SampleIdentifierToPointIndex[sampleIdentifier] = numberOfPoints;
+void
+SWCMeshIO
+::DecimateSamples(SWCParser::SampleBuffers & samples) const
+{
+  if (!(m_DecimationTolerance > 0.0))
+  {
+    return;
+  }
 
-    TypeIdentifierType typeIdentifier;
-    istrm >> typeIdentifier;
-    m_TypeIdentifiers->push_back(typeIdentifier);
+  const SizeValueType numberOfSamples = samples.Size();
+  SWCIdentifierIndex  sampleIndex;
+  sampleIndex.Build(samples.SampleIdentifiers.data(), numberOfSamples);
+  std::vector<IdentifierType> parentIndices(numberOfSamples);
+  std::vector<uint32_t>       numberOfChildren(numberOfSamples);
+  std::vector<IdentifierType> lastChild(numberOfSamples);
+  for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+  {
+    const NativeIdentifierType parentIdentifier = samples.ParentIdentifiers[ii];
+    const IdentifierType       parentIndex =
+      parentIdentifier == -1 ? SWCIdentifierIndex::InvalidIndex : sampleIndex.Find(parentIdentifier);
+    parentIndices[ii] = parentIndex;
+    if (parentIndex != SWCIdentifierIndex::InvalidIndex)
+    {
+      ++numberOfChildren[parentIndex];
+      lastChild[parentIndex] = ii;
+    }
+  }
+
+  // Only the samples inside an unbranched section of one type may be removed
+  const auto isRemovable = [&](IdentifierType ii) {
+    return parentIndices[ii] != SWCIdentifierIndex::InvalidIndex && numberOfChildren[ii] == 1 &&
+           samples.TypeIdentifiers[ii] == samples.TypeIdentifiers[parentIndices[ii]] &&
+           samples.TypeIdentifiers[ii] == samples.TypeIdentifiers[lastChild[ii]];
+  };
+
+  std::vector<uint8_t>        keep(numberOfSamples, 1);
+  std::vector<IdentifierType> section;
+  const auto                  decimate = [&](const auto * points) {
+    // Whether the samples of section in (anchor, last) are within tolerance
+    // of the segment from anchor to last, in position and in radius
+    const auto isReplaceable = [&](SizeValueType anchor, SizeValueType last) {
+      const IdentifierType first = section[anchor];
+      double               chord[3];
+      double               squaredChordLength = 0.0;
+      for (unsigned int jj = 0; jj < 3; ++jj)
+      {
+        chord[jj] = static_cast<double>(points[3 * section[last] + jj]) - static_cast<double>(points[3 * first + jj]);
+        squaredChordLength += chord[jj] * chord[jj];
+      }
+      const double inverseSquaredChordLength = squaredChordLength > 0.0 ? 1.0 / squaredChordLength : 0.0;
+      const double radiusDifference = samples.Radii[section[last]] - samples.Radii[first];
+      for (SizeValueType kk = anchor + 1; kk < last; ++kk)
+      {
+        const IdentifierType sample = section[kk];
+        double               offset[3];
+        double               projection = 0.0;
+        for (unsigned int jj = 0; jj < 3; ++jj)
+        {
+          offset[jj] = static_cast<double>(points[3 * sample + jj]) - static_cast<double>(points[3 * first + jj]);
+          projection += chord[jj] * offset[jj];
+        }
+        const double parameter = std::min(1.0, std::max(0.0, projection * inverseSquaredChordLength));
+        double       squaredDistance = 0.0;
+        for (unsigned int jj = 0; jj < 3; ++jj)
+        {
+          const double difference = offset[jj] - parameter * chord[jj];
+          squaredDistance += difference * difference;
+        }
+        const double radius = samples.Radii[sample];
+        const double tolerance =
+          m_ScaleDecimationToleranceByRadius ? m_DecimationTolerance * radius : m_DecimationTolerance;
+        if (squaredDistance > tolerance * tolerance ||
+            std::abs(radius - samples.Radii[first] - parameter * radiusDifference) > tolerance)
+        {
+          return false;
+        }
+      }
+      return true;
+    };
 
-    double pointComponent;
-    istrm >> pointComponent;
-    m_PointsBuffer->push_back(pointComponent);
-    istrm >> pointComponent;
-    m_PointsBuffer->push_back(pointComponent);
-    istrm >> pointComponent;
-    m_PointsBuffer->push_back(pointComponent);
+    for (SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+    {
+      // A section runs from a sample that is kept through the removable
+      // samples below it, to the next sample that is kept. Every removable
+      // sample is in one section, except on cycles, which are kept.
+      const IdentifierType parentIndex = parentIndices[ii];
+      if (parentIndex == SWCIdentifierIndex::InvalidIndex || isRemovable(parentIndex) || !isRemovable(ii))
+      {
+        continue;
+      }
+      section.assign(1, parentIndex);
+      IdentifierType current = ii;
+      while (isRemovable(current))
+      {
+        keep[current] = 0;
+        section.push_back(current);
+        current = lastChild[current];
+      }
+      section.push_back(current);
+
+      // Extend the segment from the anchor while the samples it replaces are
+      // within tolerance, otherwise keep the previous sample as the anchor
+      SizeValueType anchor = 0;
+      for (SizeValueType last = 2; last < section.size(); ++last)
+      {
+        if (last - anchor - 1 > MaximumDecimationWindow || !isReplaceable(anchor, last))
+        {
+          keep[section[last - 1]] = 1;
+          samples.ParentIdentifiers[section[last - 1]] = samples.SampleIdentifiers[section[anchor]];
+          anchor = last - 1;
+        }
+      }
+      samples.ParentIdentifiers[section.back()] = samples.SampleIdentifiers[section[anchor]];
+    }
+  };
+  if (samples.DoublePrecisionPoints)
+  {
+    decimate(samples.DoublePoints.data());
+  }
+  else
+  {
+    decimate(samples.Points.data());
+  }
+  samples.Retain(keep);
+}
 
-    double radius;
-    istrm >> radius;
-    m_Radii->push_back(radius);
+void
+SWCMeshIO
+::ValidateParsedSamples(const SWCParser::SampleBuffers & samples, const SWCParser::SampleBuffers & excludedSamples)
+{
+  m_ValidationReport.Clear();
+  if (!m_ValidateSamples)
+  {
+    return;
+  }
 
-    ParentIdentifierType parentIdentifier;
-    istrm >> parentIdentifier;
-    m_ParentIdentifiers->push_back(parentIdentifier);
-    if (parentIdentifier != -1)
+  // Samples parsed outside of the region of interest are merged back in
+  // line order, so that point indices and line numbers refer to the file
+  const SWCParser::SampleBuffers * parsedSamples = &samples;
+  SWCParser::SampleBuffers         merged;
+  if (excludedSamples.Size() > 0)
+  {
+    const auto appendSample = [&merged](const SWCParser::SampleBuffers & source, SizeValueType index) {
+      merged.SampleIdentifiers.push_back(source.SampleIdentifiers[index]);
+      merged.ParentIdentifiers.push_back(source.ParentIdentifiers[index]);
+      merged.LineNumbers.push_back(source.LineNumbers[index]);
+    };
+    SizeValueType insideIndex = 0;
+    for (SizeValueType ii = 0; ii < excludedSamples.Size(); ++ii)
     {
-      ++numberOfCells;
-      this->m_CellBufferSize += 4;
+      while (insideIndex < samples.Size() && samples.LineNumbers[insideIndex] < excludedSamples.LineNumbers[ii])
+      {
+        appendSample(samples, insideIndex++);
+      }
+      appendSample(excludedSamples, ii);
     }
+    while (insideIndex < samples.Size())
+    {
+      appendSample(samples, insideIndex++);
+    }
+    parsedSamples = &merged;
+  }
+
+  const SizeValueType numberOfSamples = parsedSamples->SampleIdentifiers.size();
+  SWCIdentifierIndex  sampleIndex;
+  sampleIndex.Build(parsedSamples->SampleIdentifiers.data(), numberOfSamples);
+  m_ValidationReport.Compute(parsedSamples->SampleIdentifiers.data(),
+                             parsedSamples->ParentIdentifiers.data(),
+                             numberOfSamples,
+                             sampleIndex,
+                             parsedSamples->LineNumbers.size() == numberOfSamples ? parsedSamples->LineNumbers.data()
+                                                                                   : nullptr);
+  if (m_ThrowOnValidationError && !m_ValidationReport.IsValid())
+  {
+    std::ostringstream report;
+    m_ValidationReport.Print(report);
+    itkExceptionMacro(<< "Invalid SWC samples in " << this->m_FileName << '\n' << report.str());
+  }
+}
 
-    std::getline(inputFile, line);
+void
+SWCMeshIO
+::AssignSampleBuffers(SWCParser::SampleBuffers & samples)
+{
+  m_SampleIdentifiers = NativeIdentifierContainerType::New();
+  m_SampleIdentifiers->CastToSTLContainer() = std::move(samples.SampleIdentifiers);
+  m_TypeIdentifiers = TypeIdentifierContainerType::New();
+  m_TypeIdentifiers->CastToSTLContainer() = std::move(samples.TypeIdentifiers);
+  m_PointsBuffer = PointsBufferContainerType::New();
+  m_PointsBuffer->CastToSTLContainer() = std::move(samples.Points);
+  m_DoublePointsBuffer = DoublePointsBufferContainerType::New();
+  m_DoublePointsBuffer->CastToSTLContainer() = std::move(samples.DoublePoints);
+  m_Radii = RadiusContainerType::New();
+  m_Radii->CastToSTLContainer() = std::move(samples.Radii);
+  m_ParentIdentifiers = NativeIdentifierContainerType::New();
+  m_ParentIdentifiers->CastToSTLContainer() = std::move(samples.ParentIdentifiers);
 
-    ++numberOfPoints;
+  m_SampleIdentifierIndex.Build(m_SampleIdentifiers->CastToSTLConstContainer().data(), m_SampleIdentifiers->size());
+}
+
+void
+SWCMeshIO
+::UpdateMeshInformation(SWCParser::SampleBuffers & samples, std::vector<uint32_t> * cells)
+{
+  this->AssignSampleBuffers(samples);
+  const SizeValueType numberOfPoints = m_SampleIdentifiers->size();
+
+  m_PointPermutation.clear();
+  if (m_SampleOrder != SWCMeshIOEnums::SWCSampleOrder::FileOrder)
+  {
+    this->ComputeSampleOrder(m_ParentIdentifiers->CastToSTLConstContainer().data(),
+                             numberOfPoints,
+                             m_SampleIdentifierIndex,
+                             m_PointPermutation);
+    PermuteTuples(m_SampleIdentifiers->CastToSTLContainer(), m_PointPermutation, 1);
+    PermuteTuples(m_TypeIdentifiers->CastToSTLContainer(), m_PointPermutation, 1);
+    if (this->HasDoublePrecisionPoints())
+    {
+      PermuteTuples(m_DoublePointsBuffer->CastToSTLContainer(), m_PointPermutation, this->m_PointDimension);
+    }
+    else
+    {
+      PermuteTuples(m_PointsBuffer->CastToSTLContainer(), m_PointPermutation, this->m_PointDimension);
+    }
+    PermuteTuples(m_Radii->CastToSTLContainer(), m_PointPermutation, 1);
+    PermuteTuples(m_ParentIdentifiers->CastToSTLContainer(), m_PointPermutation, 1);
+    m_SampleIdentifierIndex.Build(m_SampleIdentifiers->CastToSTLConstContainer().data(), numberOfPoints);
+
+    // Given cells refer to the file order
+    cells = nullptr;
   }
-  this->SetNumberOfPoints(numberOfPoints);
+
+  // The connectivity is built once here, so that ReadCells is a bulk copy.
+  // Samples whose parent is not in the file are roots, wherever they are.
+  // Given cells must be the line cells of the parents.
+  if (cells && !this->IsLineCellsBuffer(*cells))
+  {
+    itkExceptionMacro(<< "Invalid cell buffer in " << this->m_FileName);
+  }
+  if (cells)
+  {
+    m_CellsBuffer = CellsBufferContainerType::New();
+    m_CellsBuffer->CastToSTLContainer() = std::move(*cells);
+  }
+  else
+  {
+    this->ComputeCellsBuffer(m_ParentIdentifiers->CastToSTLConstContainer().data(), numberOfPoints);
+  }
+
+  this->CompleteMeshInformation();
+}
+
+void
+SWCMeshIO
+::CompleteMeshInformation()
+{
+  const SizeValueType numberOfPoints = m_SampleIdentifiers->size();
+
+  m_Topology.Clear();
+  if (m_ComputeTopology)
+  {
+    m_Topology.Build(m_ParentIdentifiers->CastToSTLConstContainer().data(), numberOfPoints, m_SampleIdentifierIndex);
+  }
+
+  const SizeValueType numberOfCells = CountCells(m_CellsBuffer->CastToSTLConstContainer());
+  this->m_CellBufferSize = m_CellsBuffer->size();
   this->SetNumberOfCells(numberOfCells);
+  this->ComputeCellDataBuffer();
+
+  this->SetNumberOfPoints(numberOfPoints);
   this->SetNumberOfPointPixels(numberOfPoints);
+  const bool hasCellData = m_CellDataContent != SWCMeshIOEnums::SWCCellData::NoCellData;
+  this->SetNumberOfCellPixels(hasCellData ? numberOfCells : 0);
 
   // If number of points is not equal zero, update points
   if (this->m_NumberOfPoints)
@@ -186,19 +1054,25 @@ SWCMeshIO
   if (this->m_NumberOfCells)
   {
     this->m_UpdateCells = true;
+    this->m_UpdateCellData = hasCellData;
   }
 
-  // Set default point component type
-  this->m_PointComponentType = IOComponentEnum::FLOAT;
-  this->m_CellComponentType = IOComponentEnum::UINT;
+  // Requested component types are written directly by ReadPoints, ReadCells
+  // and ReadPointData, otherwise they use the types of the storage
+  this->m_PointComponentType =
+    m_RequestedPointComponentType != IOComponentEnum::UNKNOWNCOMPONENTTYPE ? m_RequestedPointComponentType
+    : this->HasDoublePrecisionPoints()                                     ? IOComponentEnum::DOUBLE
+                                                                           : IOComponentEnum::FLOAT;
+  this->m_CellComponentType = m_RequestedCellComponentType != IOComponentEnum::UNKNOWNCOMPONENTTYPE
+                                ? m_RequestedCellComponentType
+                                : IOComponentEnum::UINT;
 
   this->m_PointPixelType = IOPixelEnum::SCALAR;
   this->m_NumberOfPointPixelComponents = 1;
   switch (m_PointDataContent)
   {
     case SWCMeshIOEnums::SWCPointData::SampleIdentifier:
-      // this->m_PointPixelComponentType = IOComponentEnum::SHORT;
-      this->m_PointPixelComponentType = IOComponentEnum::FLOAT;
+      this->m_PointPixelComponentType = IOComponentEnum::LONGLONG;
       break;
     case SWCMeshIOEnums::SWCPointData::TypeIdentifier:
       this->m_PointPixelComponentType = IOComponentEnum::FLOAT;
@@ -207,128 +1081,484 @@ SWCMeshIO
       this->m_PointPixelComponentType = IOComponentEnum::DOUBLE;
       break;
     case SWCMeshIOEnums::SWCPointData::ParentIdentifier:
-      // this->m_PointPixelComponentType = IOComponentEnum::SHORT;
-      this->m_PointPixelComponentType = IOComponentEnum::FLOAT;
+      this->m_PointPixelComponentType = IOComponentEnum::LONGLONG;
+      break;
+    case SWCMeshIOEnums::SWCPointData::AllAttributes:
+      this->m_PointPixelType = IOPixelEnum::VECTOR;
+      this->m_NumberOfPointPixelComponents = NumberOfAttributes;
+      this->m_PointPixelComponentType = IOComponentEnum::DOUBLE;
       break;
   }
-  this->m_CellPixelType = IOPixelEnum::SCALAR;
-  this->m_NumberOfCellPixelComponents = 1;
-
-  inputFile.close();
+  if (m_RequestedPointPixelComponentType != IOComponentEnum::UNKNOWNCOMPONENTTYPE)
+  {
+    this->m_PointPixelComponentType = m_RequestedPointPixelComponentType;
+  }
+  this->m_CellPixelType = IOPixelEnum::SCALAR;
+  this->m_NumberOfCellPixelComponents = 1;
+  if (m_CellDataContent == SWCMeshIOEnums::SWCCellData::AllGeometry)
+  {
+    this->m_CellPixelType = IOPixelEnum::VECTOR;
+    this->m_NumberOfCellPixelComponents = NumberOfSegmentMeasures;
+  }
+  this->m_CellPixelComponentType = m_RequestedCellPixelComponentType != IOComponentEnum::UNKNOWNCOMPONENTTYPE
+                                     ? m_RequestedCellPixelComponentType
+                                     : IOComponentEnum::DOUBLE;
+}
+
+void
+SWCMeshIO
+::ReadPoints(void * buffer)
+{
+  const SizeValueType numberOfValues = this->m_PointDimension * this->GetNumberOfPoints();
+  if (m_PointsBuffer->size() != numberOfValues && m_DoublePointsBuffer->size() != numberOfValues)
+  {
+    itkExceptionMacro("The points of " << this->m_FileName << " were released or not read");
+  }
+  const bool isKnownType = VisitComponentBuffer(this->m_PointComponentType, buffer, [&](auto * data) {
+    if (this->HasDoublePrecisionPoints())
+    {
+      CopyValues(m_DoublePointsBuffer->CastToSTLConstContainer().data(), numberOfValues, data);
+    }
+    else
+    {
+      CopyValues(m_PointsBuffer->CastToSTLConstContainer().data(), numberOfValues, data);
+    }
+  });
+  if (!isKnownType)
+  {
+    itkExceptionMacro(<< "Unknown point component type" << std::endl);
+  }
+  if (m_ReleaseBuffersAfterRead)
+  {
+    m_PointsBuffer = PointsBufferContainerType::New();
+    m_DoublePointsBuffer = DoublePointsBufferContainerType::New();
+  }
+}
+
+void
+SWCMeshIO
+::ReadCells(void * buffer)
+{
+  if (m_CellsBuffer->size() != this->m_CellBufferSize)
+  {
+    itkExceptionMacro("The cells of " << this->m_FileName << " were released or not read");
+  }
+  const bool isKnownType = VisitComponentBuffer(this->m_CellComponentType, buffer, [this](auto * data) {
+    CopyValues(m_CellsBuffer->CastToSTLConstContainer().data(), this->m_CellBufferSize, data);
+  });
+  if (!isKnownType)
+  {
+    itkExceptionMacro(<< "Unknown cell component type" << std::endl);
+  }
+  if (m_ReleaseBuffersAfterRead)
+  {
+    m_CellsBuffer = CellsBufferContainerType::New();
+  }
+}
+
+void
+SWCMeshIO
+::ComputeSampleOrder(const NativeIdentifierType *      parentIdentifiers,
+                     SizeValueType                     numberOfPoints,
+                     const SWCIdentifierIndex &        sampleIdentifierIndex,
+                     SWCTopology::IndexContainerType & order) const
+{
+  SWCTopology topology;
+  topology.Build(parentIdentifiers, numberOfPoints, sampleIdentifierIndex);
+  if (m_SampleOrder == SWCMeshIOEnums::SWCSampleOrder::BreadthFirst)
+  {
+    topology.BreadthFirstOrder(order);
+  }
+  else
+  {
+    topology.DepthFirstOrder(order);
+  }
+
+  // Points on parent cycles are not reachable from a root
+  if (order.size() < numberOfPoints)
+  {
+    std::vector<bool> isVisited(numberOfPoints);
+    for (const auto pointIndex : order)
+    {
+      isVisited[pointIndex] = true;
+    }
+    for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+    {
+      if (!isVisited[ii])
+      {
+        order.push_back(ii);
+      }
+    }
+  }
+}
+
+void
+SWCMeshIO
+::ComputeCellsBuffer(const NativeIdentifierType * parentIdentifiers, SizeValueType numberOfPoints)
+{
+  if (m_UsePolyLineCells)
+  {
+    this->ComputePolyLineCellsBuffer(parentIdentifiers, numberOfPoints);
+  }
+  else
+  {
+    this->ComputeLineCellsBuffer(parentIdentifiers, numberOfPoints);
+  }
+}
+
+void
+SWCMeshIO
+::ComputeLineCellsBuffer(const NativeIdentifierType * parentIdentifiers, SizeValueType numberOfPoints)
+{
+  m_CellsBuffer = CellsBufferContainerType::New();
+  auto & cells = m_CellsBuffer->CastToSTLContainer();
+  cells.reserve(4 * numberOfPoints);
+  for (SizeValueType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+  {
+    const auto parentIdentifier = parentIdentifiers[pointIndex];
+    const auto parentIndex =
+      parentIdentifier != -1 ? m_SampleIdentifierIndex.Find(parentIdentifier) : SWCIdentifierIndex::InvalidIndex;
+    if (parentIndex != SWCIdentifierIndex::InvalidIndex)
+    {
+      cells.push_back(static_cast<uint32_t>(CommonEnums::CellGeometry::LINE_CELL));
+      cells.push_back(2);
+      cells.push_back(static_cast<uint32_t>(parentIndex));
+      cells.push_back(static_cast<uint32_t>(pointIndex));
+    }
+  }
+}
+
+bool
+SWCMeshIO
+::IsLineCellsBuffer(const std::vector<uint32_t> & cells) const
+{
+  const NativeIdentifierType * parentIdentifiers = m_ParentIdentifiers->CastToSTLConstContainer().data();
+  const SizeValueType          numberOfPoints = m_ParentIdentifiers->size();
+  SizeValueType                index = 0;
+  for (SizeValueType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+  {
+    const auto parentIdentifier = parentIdentifiers[pointIndex];
+    const auto parentIndex =
+      parentIdentifier != -1 ? m_SampleIdentifierIndex.Find(parentIdentifier) : SWCIdentifierIndex::InvalidIndex;
+    if (parentIndex != SWCIdentifierIndex::InvalidIndex)
+    {
+      if (cells.size() - index < 4 || cells[index] != static_cast<uint32_t>(CommonEnums::CellGeometry::LINE_CELL) ||
+          cells[index + 1] != 2 || cells[index + 2] != parentIndex || cells[index + 3] != pointIndex)
+      {
+        return false;
+      }
+      index += 4;
+    }
+  }
+  return index == cells.size();
+}
+
+void
+SWCMeshIO
+::ComputePolyLineCellsBuffer(const NativeIdentifierType * parentIdentifiers, SizeValueType numberOfPoints)
+{
+  // Count the children of every sample, and keep the last one, which is the
+  // only one inside an unbranched section
+  std::vector<IdentifierType> parentIndices(numberOfPoints);
+  std::vector<uint32_t>       numberOfChildren(numberOfPoints);
+  std::vector<IdentifierType> lastChild(numberOfPoints);
+  for (SizeValueType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+  {
+    const auto parentIdentifier = parentIdentifiers[pointIndex];
+    const auto parentIndex =
+      parentIdentifier != -1 ? m_SampleIdentifierIndex.Find(parentIdentifier) : SWCIdentifierIndex::InvalidIndex;
+    parentIndices[pointIndex] = parentIndex;
+    if (parentIndex != SWCIdentifierIndex::InvalidIndex)
+    {
+      ++numberOfChildren[parentIndex];
+      lastChild[parentIndex] = pointIndex;
+    }
+  }
+
+  // A section starts at every child of a root or branch point, and follows
+  // the only children up to a branch point or tip. Every sample with a
+  // parent ends up in exactly one section, except on cycles without a
+  // branch point, whose segments are emitted afterwards as two-point
+  // polylines.
+  m_CellsBuffer = CellsBufferContainerType::New();
+  auto & cells = m_CellsBuffer->CastToSTLContainer();
+  cells.reserve(numberOfPoints + numberOfPoints / 2);
+  std::vector<uint8_t> isVisited(numberOfPoints);
+  for (SizeValueType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+  {
+    const IdentifierType parentIndex = parentIndices[pointIndex];
+    if (parentIndex == SWCIdentifierIndex::InvalidIndex ||
+        (parentIndices[parentIndex] != SWCIdentifierIndex::InvalidIndex && numberOfChildren[parentIndex] == 1))
+    {
+      continue;
+    }
+    const SizeValueType first = cells.size();
+    cells.push_back(static_cast<uint32_t>(CommonEnums::CellGeometry::POLYLINE_CELL));
+    cells.push_back(0);
+    cells.push_back(static_cast<uint32_t>(parentIndex));
+    IdentifierType current = pointIndex;
+    while (true)
+    {
+      isVisited[current] = 1;
+      cells.push_back(static_cast<uint32_t>(current));
+      if (numberOfChildren[current] != 1 || isVisited[lastChild[current]])
+      {
+        break;
+      }
+      current = lastChild[current];
+    }
+    cells[first + 1] = static_cast<uint32_t>(cells.size() - first - 2);
+  }
+  for (SizeValueType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+  {
+    if (parentIndices[pointIndex] != SWCIdentifierIndex::InvalidIndex && !isVisited[pointIndex])
+    {
+      cells.push_back(static_cast<uint32_t>(CommonEnums::CellGeometry::POLYLINE_CELL));
+      cells.push_back(2);
+      cells.push_back(static_cast<uint32_t>(parentIndices[pointIndex]));
+      cells.push_back(static_cast<uint32_t>(pointIndex));
+    }
+  }
+}
+
+void
+SWCMeshIO
+::ReadPointData(void * buffer)
+{
+  const SizeValueType numberOfPoints = this->GetNumberOfPoints();
+  if (m_SampleIdentifiers->size() != numberOfPoints)
+  {
+    itkExceptionMacro("The point data of " << this->m_FileName << " was released or not read");
+  }
+  const bool isKnownType = VisitComponentBuffer(this->m_PointPixelComponentType, buffer, [&](auto * data) {
+    using ComponentType = std::remove_pointer_t<decltype(data)>;
+    switch (m_PointDataContent)
+    {
+      case SWCMeshIOEnums::SWCPointData::SampleIdentifier:
+        CopyValues(m_SampleIdentifiers->CastToSTLConstContainer().data(), numberOfPoints, data);
+        break;
+      case SWCMeshIOEnums::SWCPointData::TypeIdentifier:
+        CopyValues(m_TypeIdentifiers->CastToSTLConstContainer().data(), numberOfPoints, data);
+        break;
+      case SWCMeshIOEnums::SWCPointData::Radius:
+        CopyValues(m_Radii->CastToSTLConstContainer().data(), numberOfPoints, data);
+        break;
+      case SWCMeshIOEnums::SWCPointData::ParentIdentifier:
+        CopyValues(m_ParentIdentifiers->CastToSTLConstContainer().data(), numberOfPoints, data);
+        break;
+      case SWCMeshIOEnums::SWCPointData::AllAttributes:
+        for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+        {
+          *data++ = static_cast<ComponentType>(m_SampleIdentifiers->GetElement(ii));
+          *data++ = static_cast<ComponentType>(m_TypeIdentifiers->GetElement(ii));
+          *data++ = static_cast<ComponentType>(m_Radii->GetElement(ii));
+          *data++ = static_cast<ComponentType>(m_ParentIdentifiers->GetElement(ii));
+        }
+        break;
+    }
+  });
+  if (!isKnownType)
+  {
+    itkExceptionMacro(<< "Unknown point pixel component type" << std::endl);
+  }
+  if (m_ReleaseBuffersAfterRead)
+  {
+    m_SampleIdentifiers = NativeIdentifierContainerType::New();
+    m_TypeIdentifiers = TypeIdentifierContainerType::New();
+    m_Radii = RadiusContainerType::New();
+    m_ParentIdentifiers = NativeIdentifierContainerType::New();
+    m_SampleIdentifierIndex.Clear();
+  }
+}
+
+const IdentifierType *
+SWCMeshIO
+::GetParentPointIndices(SWCTopology::IndexContainerType & storage) const
+{
+  // The topology holds the parent point indices, otherwise they are
+  // resolved through the sample identifier index
+  const SizeValueType numberOfPoints = this->GetNumberOfPoints();
+  if (m_Topology.GetNumberOfPoints() == numberOfPoints)
+  {
+    return m_Topology.GetParentPointIndices().data();
+  }
+  storage.resize(numberOfPoints);
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    const auto parentIdentifier = m_ParentIdentifiers->GetElement(ii);
+    storage[ii] = parentIdentifier != -1 ? m_SampleIdentifierIndex.Find(parentIdentifier) : SWCTopology::InvalidIndex;
+  }
+  return storage.data();
 }
 
 void
 SWCMeshIO
-::ReadPoints(void * buffer)
+::ComputeMorphometrics(SWCMorphometrics & morphometrics) const
 {
-  auto * data = static_cast<float *>(buffer);
-  const SizeValueType numberOfValues = this->m_PointDimension * this->GetNumberOfPoints();
-  for (SizeValueType ii = 0; ii < numberOfValues; ++ii)
+  const SizeValueType numberOfPoints = this->GetNumberOfPoints();
+  const SizeValueType numberOfValues = this->m_PointDimension * numberOfPoints;
+  if ((m_PointsBuffer->size() != numberOfValues && m_DoublePointsBuffer->size() != numberOfValues) ||
+      m_Radii->size() != numberOfPoints || m_TypeIdentifiers->size() != numberOfPoints ||
+      m_ParentIdentifiers->size() != numberOfPoints)
+  {
+    itkExceptionMacro("The samples of " << this->m_FileName << " were released or not read");
+  }
+
+  SWCTopology::IndexContainerType parentPointIndexStorage;
+  const IdentifierType *          parentPointIndices = this->GetParentPointIndices(parentPointIndexStorage);
+  const double *                  radii = m_Radii->CastToSTLConstContainer().data();
+  const TypeIdentifierType *      typeIdentifiers = m_TypeIdentifiers->CastToSTLConstContainer().data();
+  if (this->HasDoublePrecisionPoints())
+  {
+    morphometrics.Compute(m_DoublePointsBuffer->CastToSTLConstContainer().data(),
+                          radii,
+                          typeIdentifiers,
+                          parentPointIndices,
+                          numberOfPoints);
+  }
+  else
   {
-    data[ii] = this->m_PointsBuffer->GetElement(ii);
+    morphometrics.Compute(
+      m_PointsBuffer->CastToSTLConstContainer().data(), radii, typeIdentifiers, parentPointIndices, numberOfPoints);
   }
 }
 
 void
 SWCMeshIO
-::ReadCells(void * buffer)
+::BuildSegmentLocator(SWCSegmentLocator & locator) const
 {
-  auto * data = static_cast<unsigned int *>(buffer);
+  const SizeValueType numberOfPoints = this->GetNumberOfPoints();
+  const SizeValueType numberOfValues = this->m_PointDimension * numberOfPoints;
+  if ((m_PointsBuffer->size() != numberOfValues && m_DoublePointsBuffer->size() != numberOfValues) ||
+      m_Radii->size() != numberOfPoints || m_ParentIdentifiers->size() != numberOfPoints)
+  {
+    itkExceptionMacro("The samples of " << this->m_FileName << " were released or not read");
+  }
 
-  // Skip root
-  SizeValueType cellBufferIndex = 0;
-  for (SizeValueType pointIndex = 1; pointIndex < this->GetNumberOfPoints(); ++pointIndex)
+  SWCTopology::IndexContainerType parentPointIndexStorage;
+  const IdentifierType *          parentPointIndices = this->GetParentPointIndices(parentPointIndexStorage);
+  const double *                  radii = m_Radii->CastToSTLConstContainer().data();
+  if (this->HasDoublePrecisionPoints())
   {
-    const auto sampleIdentifier = m_SampleIdentifiers->GetElement(pointIndex);
-    const auto parentIdentifier = m_ParentIdentifiers->GetElement(pointIndex);
-    if (parentIdentifier != -1)
-    {
-      data[cellBufferIndex++] = static_cast<uint32_t>(CommonEnums::CellGeometry::LINE_CELL);
-      data[cellBufferIndex++] = 2;
-      data[cellBufferIndex++] = m_SampleIdentifierToPointIndex[parentIdentifier];
-      data[cellBufferIndex++] = m_SampleIdentifierToPointIndex[sampleIdentifier];
-    }
+    locator.Build(m_DoublePointsBuffer->CastToSTLConstContainer().data(), radii, parentPointIndices, numberOfPoints);
+  }
+  else
+  {
+    locator.Build(m_PointsBuffer->CastToSTLConstContainer().data(), radii, parentPointIndices, numberOfPoints);
   }
 }
 
 void
 SWCMeshIO
-::ReadPointData(void * buffer)
+::ReleaseBuffers()
 {
-  const SizeValueType numberOfPoints = this->GetNumberOfPoints();
-  switch (m_PointDataContent)
+  m_SampleIdentifiers = NativeIdentifierContainerType::New();
+  m_TypeIdentifiers = TypeIdentifierContainerType::New();
+  m_Radii = RadiusContainerType::New();
+  m_ParentIdentifiers = NativeIdentifierContainerType::New();
+  m_PointsBuffer = PointsBufferContainerType::New();
+  m_DoublePointsBuffer = DoublePointsBufferContainerType::New();
+  m_CellsBuffer = CellsBufferContainerType::New();
+  m_CellDataBuffer = CellDataBufferContainerType::New();
+  m_SampleIdentifierIndex.Clear();
+}
+
+void
+SWCMeshIO
+::ComputeCellDataBuffer()
+{
+  m_CellDataBuffer = CellDataBufferContainerType::New();
+  if (m_CellDataContent == SWCMeshIOEnums::SWCCellData::NoCellData)
   {
-    case SWCMeshIOEnums::SWCPointData::SampleIdentifier:
-      {
-      auto * data = static_cast<SampleIdentifierType *>(buffer);
-      for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
-      {
-        data[ii] = m_SampleIdentifiers->GetElement(ii);
-      }
-      }
+    return;
+  }
+
+  const SizeValueType numberOfCells = this->m_NumberOfCells;
+  const unsigned int  numberOfComponents =
+    m_CellDataContent == SWCMeshIOEnums::SWCCellData::AllGeometry ? NumberOfSegmentMeasures : 1;
+  auto & cellData = m_CellDataBuffer->CastToSTLContainer();
+  cellData.resize(numberOfComponents * numberOfCells);
+  double * data = cellData.data();
+  auto     forEachSegment = [this, numberOfCells](auto && measure) {
+    const double *   radii = m_Radii->CastToSTLConstContainer().data();
+    const uint32_t * cells = m_CellsBuffer->CastToSTLConstContainer().data();
+    if (this->HasDoublePrecisionPoints())
+    {
+      ForEachSegment(m_DoublePointsBuffer->CastToSTLConstContainer().data(),
+                     this->m_PointDimension,
+                     radii,
+                     cells,
+                     numberOfCells,
+                     measure);
+    }
+    else
+    {
+      ForEachSegment(
+        m_PointsBuffer->CastToSTLConstContainer().data(), this->m_PointDimension, radii, cells, numberOfCells, measure);
+    }
+  };
+  switch (m_CellDataContent)
+  {
+    case SWCMeshIOEnums::SWCCellData::Length:
+      forEachSegment([data](double squaredLength, double, double, SizeValueType cell) {
+        data[cell] += std::sqrt(squaredLength);
+      });
       break;
-    case SWCMeshIOEnums::SWCPointData::TypeIdentifier:
-      {
-      auto * data = static_cast<TypeIdentifierType *>(buffer);
-      for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
-      {
-        data[ii] = m_TypeIdentifiers->GetElement(ii);
-      }
-      }
+    case SWCMeshIOEnums::SWCCellData::Volume:
+      forEachSegment([data](double squaredLength, double radius0, double radius1, SizeValueType cell) {
+        data[cell] += FrustumVolume(squaredLength, radius0, radius1);
+      });
       break;
-    case SWCMeshIOEnums::SWCPointData::Radius:
-      {
-      auto * data = static_cast<RadiusType *>(buffer);
-      for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
-      {
-        data[ii] = m_Radii->GetElement(ii);
-      }
-      }
+    case SWCMeshIOEnums::SWCCellData::LateralArea:
+      forEachSegment([data](double squaredLength, double radius0, double radius1, SizeValueType cell) {
+        data[cell] += FrustumLateralArea(squaredLength, radius0, radius1);
+      });
       break;
-    case SWCMeshIOEnums::SWCPointData::ParentIdentifier:
-      {
-      auto * data = static_cast<ParentIdentifierType *>(buffer);
-      for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
-      {
-        data[ii] = m_ParentIdentifiers->GetElement(ii);
-      }
-      }
+    case SWCMeshIOEnums::SWCCellData::AllGeometry:
+      forEachSegment([data](double squaredLength, double radius0, double radius1, SizeValueType cell) {
+        double * measures = data + NumberOfSegmentMeasures * cell;
+        measures[0] += std::sqrt(squaredLength);
+        measures[1] += FrustumVolume(squaredLength, radius0, radius1);
+        measures[2] += FrustumLateralArea(squaredLength, radius0, radius1);
+      });
+      break;
+    default:
       break;
   }
 }
 
 void
 SWCMeshIO
-::ReadCellData(void * itkNotUsed(buffer))
-{}
+::ReadCellData(void * buffer)
+{
+  const SizeValueType numberOfValues = this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents;
+  if (m_CellDataBuffer->size() != numberOfValues)
+  {
+    itkExceptionMacro("The cell data of " << this->m_FileName << " was released or not read");
+  }
+  const bool isKnownType = VisitComponentBuffer(this->m_CellPixelComponentType, buffer, [&](auto * data) {
+    CopyValues(m_CellDataBuffer->CastToSTLConstContainer().data(), numberOfValues, data);
+  });
+  if (!isKnownType)
+  {
+    itkExceptionMacro(<< "Unknown cell pixel component type" << std::endl);
+  }
+  if (m_ReleaseBuffersAfterRead)
+  {
+    m_CellDataBuffer = CellDataBufferContainerType::New();
+  }
+}
 
 
 void
 SWCMeshIO
 ::WriteMeshInformation()
 {
-  // Check file name
+  // Check file name. The file itself is opened once, in Write().
   if (this->m_FileName.empty())
   {
     itkExceptionMacro("No Input FileName");
   }
-
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios::out);
-
-  if (!outputFile.is_open())
-  {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= "
-                      << this->m_FileName);
-  }
-
-  for (size_t headerLineIndex = 0; headerLineIndex < m_HeaderContent.size(); ++headerLineIndex)
-  {
-    outputFile << "#" << m_HeaderContent[headerLineIndex] << "\n";
-  }
-
-  outputFile.close();
 }
 
 void
@@ -422,39 +1652,13 @@ SWCMeshIO
   }
 
   m_PointIndexToParentPointIndex.clear();
-  for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
-  {
-    if (ii < m_SampleIdentifiers->size())
-    {
-      m_PointIndexToSampleIdentifier[ii] = m_SampleIdentifiers->GetElement(ii);
-    } else
-    {
-      m_PointIndexToSampleIdentifier[ii] = ii;
-    }
-  }
 }
 
 void
 SWCMeshIO
 ::WriteCells(void * buffer)
 {
-  // Check file name
-  if (this->m_FileName.empty())
-  {
-    itkExceptionMacro("No Input FileName");
-  }
-
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app);
-
-  if (!outputFile.is_open())
-  {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= "
-                      << this->m_FileName);
-  }
-
-  // Write polygons
+  // Convert cells to parent identifiers
   switch (this->m_CellComponentType)
   {
     case IOComponentEnum::UCHAR:
@@ -634,73 +1838,179 @@ SWCMeshIO
     itkExceptionMacro("No Input FileName");
   }
 
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios::out | std::ios::app);
-
-  if (!outputFile.is_open())
+  // Write to output file, gzip-compressed for .gz file names or when
+  // UseCompression is on
+  const bool compress = this->m_UseCompression || itksys::SystemTools::StringEndsWith(this->m_FileName, ".gz");
+  SWCOutputFileStream outputFile;
+  if (!outputFile.Open(this->m_FileName, compress ? m_CompressionLevel : 0))
   {
     itkExceptionMacro("Unable to open file\n"
                       "outputFilename= "
                       << this->m_FileName);
   }
 
-  const auto sampleIdentifiersSize = m_SampleIdentifiers->size();
-  const auto typeIdentifiersSize = m_TypeIdentifiers->size();
-  const auto radiiSize = m_Radii->size();
-  const auto parentIdentifiersSize = m_ParentIdentifiers->size();
-  const std::string sep(" ");
-  SizeValueType pointsIndex = itk::NumericTraits<SizeValueType>::ZeroValue();
-  for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
+  std::string header;
+  for (const auto & headerLine : m_HeaderContent)
   {
-    if (ii < sampleIdentifiersSize)
-    {
-      outputFile << m_SampleIdentifiers->GetElement(ii);
-    }
-    else
+    header += '#';
+    header += headerLine;
+    header += '\n';
+  }
+  outputFile.Write(header.data(), header.size());
+
+  // Rows are written in m_SampleOrder, through the point index of each row
+  SWCTopology::IndexContainerType rowOrder;
+  if (m_SampleOrder != SWCMeshIOEnums::SWCSampleOrder::FileOrder &&
+      m_ParentIdentifiers->size() == this->m_NumberOfPoints)
+  {
+    std::vector<NativeIdentifierType> sampleIdentifiers(m_SampleIdentifiers->begin(), m_SampleIdentifiers->end());
+    for (SizeValueType ii = sampleIdentifiers.size(); ii < this->m_NumberOfPoints; ++ii)
     {
-      outputFile << ii+1;
+      sampleIdentifiers.push_back(static_cast<NativeIdentifierType>(ii + 1));
     }
-    outputFile << sep;
+    SWCIdentifierIndex sampleIdentifierIndex;
+    sampleIdentifierIndex.Build(sampleIdentifiers.data(), this->m_NumberOfPoints);
+    this->ComputeSampleOrder(m_ParentIdentifiers->CastToSTLConstContainer().data(),
+                             this->m_NumberOfPoints,
+                             sampleIdentifierIndex,
+                             rowOrder);
+  }
+  const auto rowPointIndex = [&rowOrder](SizeValueType row) { return rowOrder.empty() ? row : rowOrder[row]; };
 
-    if (ii < typeIdentifiersSize)
+  const SizeValueType maximumLineLength = this->GetMaximumLineLength();
+  if (m_NumberOfWorkUnits == 1)
+  {
+    // Rows are formatted into a reusable buffer that is flushed in large blocks
+    std::vector<char> buffer(WriteBlockSize + maximumLineLength);
+    char * const bufferBegin = buffer.data();
+    char * cursor = bufferBegin;
+    for (SizeValueType ii = 0; ii < this->m_NumberOfPoints; ++ii)
     {
-      outputFile << m_TypeIdentifiers->GetElement(ii);
+      cursor = this->FormatSample(rowPointIndex(ii), cursor);
+      if (static_cast<SizeValueType>(cursor - bufferBegin) >= WriteBlockSize)
+      {
+        outputFile.Write(bufferBegin, cursor - bufferBegin);
+        cursor = bufferBegin;
+      }
     }
-    else
+    outputFile.Write(bufferBegin, cursor - bufferBegin);
+  }
+  else
+  {
+    // Each work unit formats a contiguous range of rows into its own buffer.
+    // The buffers are then written in order, so the output is identical to a
+    // serial write.
+    const auto multiThreader = MultiThreaderBase::New();
+    multiThreader->SetMaximumNumberOfThreads(m_NumberOfWorkUnits);
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+
+    const SizeValueType numberOfChunks = m_NumberOfWorkUnits;
+    const SizeValueType chunkBlockSize = std::min(WriteBlockSize, MaximumParallelBlockSize / numberOfChunks);
+    const SizeValueType rowsPerChunk = std::max<SizeValueType>(chunkBlockSize / maximumLineLength, 1);
+    std::vector<std::vector<char>> chunkBuffers(numberOfChunks);
+    std::vector<SizeValueType> chunkSizes(numberOfChunks);
+    for (SizeValueType firstRow = 0; firstRow < this->m_NumberOfPoints; firstRow += numberOfChunks * rowsPerChunk)
     {
-      outputFile << 5;
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfChunks,
+        [&](SizeValueType chunk) {
+          const SizeValueType chunkFirstRow = std::min(firstRow + chunk * rowsPerChunk, this->m_NumberOfPoints);
+          const SizeValueType chunkLastRow = std::min(chunkFirstRow + rowsPerChunk, this->m_NumberOfPoints);
+          auto & chunkBuffer = chunkBuffers[chunk];
+          chunkBuffer.resize(rowsPerChunk * maximumLineLength);
+          char * cursor = chunkBuffer.data();
+          for (SizeValueType ii = chunkFirstRow; ii < chunkLastRow; ++ii)
+          {
+            cursor = this->FormatSample(rowPointIndex(ii), cursor);
+          }
+          chunkSizes[chunk] = static_cast<SizeValueType>(cursor - chunkBuffer.data());
+        },
+        nullptr);
+
+      for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+      {
+        outputFile.Write(chunkBuffers[chunk].data(), chunkSizes[chunk]);
+      }
     }
-    outputFile << sep;
+  }
 
-    for (unsigned int jj = 0; jj < this->m_PointDimension; ++jj)
-    {
-      outputFile << ConvertNumberToString(m_PointsBuffer->GetElement(pointsIndex++));
-      outputFile << sep;
-    }
+  if (!outputFile.Close())
+  {
+    itkExceptionMacro("Failed to write file\n"
+                      "outputFilename= "
+                      << this->m_FileName);
+  }
+}
 
-    if (ii < radiiSize)
-    {
-      outputFile << m_Radii->GetElement(ii);
-    }
-    else
-    {
-      outputFile << 1.0;
-    }
-    outputFile << sep;
+SizeValueType
+SWCMeshIO
+::GetMaximumLineLength() const
+{
+  // Each column takes at most 24 characters for a double in shortest
+  // round-trip form, plus its separator.
+  return (NumberOfAttributes + this->m_PointDimension) * 32;
+}
 
-    if (ii < parentIdentifiersSize)
-    {
-      outputFile << m_ParentIdentifiers->GetElement(ii);
-    }
-    else
-    {
-      outputFile << -1;
-    }
+char *
+SWCMeshIO
+::FormatSample(SizeValueType pointIndex, char * buffer) const
+{
+  // Enough for any column, so that ToChars cannot fail
+  constexpr ptrdiff_t fieldLength = 32;
+
+  if (pointIndex < m_SampleIdentifiers->size())
+  {
+    buffer = ToChars(buffer, buffer + fieldLength, m_SampleIdentifiers->GetElement(pointIndex));
+  }
+  else
+  {
+    buffer = ToChars(buffer, buffer + fieldLength, pointIndex + 1);
+  }
+  *buffer++ = ' ';
+
+  if (pointIndex < m_TypeIdentifiers->size())
+  {
+    buffer = ToChars(buffer, buffer + fieldLength, m_TypeIdentifiers->GetElement(pointIndex));
+  }
+  else
+  {
+    *buffer++ = '5';
+  }
+  *buffer++ = ' ';
+
+  SizeValueType pointsIndex = pointIndex * this->m_PointDimension;
+  const bool    hasDoublePrecisionPoints = this->HasDoublePrecisionPoints();
+  for (unsigned int jj = 0; jj < this->m_PointDimension; ++jj)
+  {
+    buffer = hasDoublePrecisionPoints
+               ? ToChars(buffer, buffer + fieldLength, m_DoublePointsBuffer->GetElement(pointsIndex++))
+               : ToChars(buffer, buffer + fieldLength, m_PointsBuffer->GetElement(pointsIndex++));
+    *buffer++ = ' ';
+  }
+
+  if (pointIndex < m_Radii->size())
+  {
+    buffer = ToChars(buffer, buffer + fieldLength, m_Radii->GetElement(pointIndex));
+  }
+  else
+  {
+    *buffer++ = '1';
+  }
+  *buffer++ = ' ';
 
-    outputFile << "\n";
+  if (pointIndex < m_ParentIdentifiers->size())
+  {
+    buffer = ToChars(buffer, buffer + fieldLength, m_ParentIdentifiers->GetElement(pointIndex));
   }
+  else
+  {
+    *buffer++ = '-';
+    *buffer++ = '1';
+  }
+  *buffer++ = '\n';
 
-  outputFile.close();
+  return buffer;
 }
 
 void
@@ -710,24 +2020,103 @@ SWCMeshIO
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Header Lines: " << m_HeaderContent.size() << std::endl;
+  os << indent << "PointDataContent: " << m_PointDataContent << std::endl;
+  os << indent << "CellDataContent: " << m_CellDataContent << std::endl;
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+  os << indent << "ComputeTopology: " << (m_ComputeTopology ? "On" : "Off") << std::endl;
+  os << indent << "UsePolyLineCells: " << (m_UsePolyLineCells ? "On" : "Off") << std::endl;
+  os << indent << "SampleOrder: " << m_SampleOrder << std::endl;
+  os << indent << "ValidateSamples: " << (m_ValidateSamples ? "On" : "Off") << std::endl;
+  os << indent << "ThrowOnValidationError: " << (m_ThrowOnValidationError ? "On" : "Off") << std::endl;
+  os << indent << "PointPermutation: " << m_PointPermutation.size() << std::endl;
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+  os << indent << "ReleaseBuffersAfterRead: " << (m_ReleaseBuffersAfterRead ? "On" : "Off") << std::endl;
+  os << indent << "UseRegionOfInterest: " << (m_UseRegionOfInterest ? "On" : "Off") << std::endl;
+  os << indent << "RegionOfInterestMinimum: " << m_RegionOfInterestMinimum[0] << ' ' << m_RegionOfInterestMinimum[1]
+     << ' ' << m_RegionOfInterestMinimum[2] << std::endl;
+  os << indent << "RegionOfInterestMaximum: " << m_RegionOfInterestMaximum[0] << ' ' << m_RegionOfInterestMaximum[1]
+     << ' ' << m_RegionOfInterestMaximum[2] << std::endl;
+  os << indent << "PadRegionOfInterestByRadius: " << (m_PadRegionOfInterestByRadius ? "On" : "Off") << std::endl;
+  os << indent << "RegionOfInterestBoundary: " << m_RegionOfInterestBoundary << std::endl;
+  os << indent << "SubtreeRootIdentifier: " << m_SubtreeRootIdentifier << std::endl;
+  os << indent << "SubtreeTypeIdentifiers:";
+  for (const auto typeIdentifier : m_SubtreeTypeIdentifiers)
+  {
+    os << ' ' << typeIdentifier;
+  }
+  os << std::endl;
+  os << indent << "DecimationTolerance: " << m_DecimationTolerance << std::endl;
+  os << indent << "ScaleDecimationToleranceByRadius: " << (m_ScaleDecimationToleranceByRadius ? "On" : "Off")
+     << std::endl;
+  os << indent << "RequestedPointComponentType: " << m_RequestedPointComponentType << std::endl;
+  os << indent << "RequestedCellComponentType: " << m_RequestedCellComponentType << std::endl;
+  os << indent << "RequestedPointPixelComponentType: " << m_RequestedPointPixelComponentType << std::endl;
+  os << indent << "RequestedCellPixelComponentType: " << m_RequestedCellPixelComponentType << std::endl;
 }
 
 void
 SWCMeshIO
 ::SetSampleIdentifiers(const SampleIdentifierContainerType * sampleIdentifiers)
 {
-  const SizeValueType size = sampleIdentifiers->Size();
-  m_SampleIdentifiers->resize(size);
-  for (SizeValueType ii = 0; ii < size; ++ii)
+  const auto & values = sampleIdentifiers->CastToSTLConstContainer();
+  m_SampleIdentifiers = NativeIdentifierContainerType::New();
+  m_SampleIdentifiers->CastToSTLContainer().assign(values.begin(), values.end());
+  this->Modified();
+}
+
+auto
+SWCMeshIO
+::GetSampleIdentifiers() const -> SampleIdentifierContainerType::ConstPointer
+{
+  // A new container, so that concurrent callers do not share one
+  const auto & values = m_SampleIdentifiers->CastToSTLConstContainer();
+  auto         sampleIdentifiers = SampleIdentifierContainerType::New();
+  sampleIdentifiers->CastToSTLContainer().assign(values.begin(), values.end());
+  return sampleIdentifiers;
+}
+
+void
+SWCMeshIO
+::SetNativeSampleIdentifiers(const NativeIdentifierContainerType * sampleIdentifiers)
+{
+  if (m_SampleIdentifiers != sampleIdentifiers)
+  {
+    m_SampleIdentifiers = NativeIdentifierContainerType::New();
+    m_SampleIdentifiers->CastToSTLContainer() = sampleIdentifiers->CastToSTLConstContainer();
+    this->Modified();
+  }
+}
+
+void
+SWCMeshIO
+::SetNativeSampleIdentifiers(NativeIdentifierContainerType * sampleIdentifiers)
+{
+  if (m_SampleIdentifiers != sampleIdentifiers)
   {
-    m_SampleIdentifiers->SetElement(ii, sampleIdentifiers->GetElement(ii));
+    m_SampleIdentifiers = sampleIdentifiers;
+    this->Modified();
   }
+}
+
+void
+SWCMeshIO
+::SetNativeSampleIdentifiers(NativeIdentifierContainerType::STLContainerType && sampleIdentifiers)
+{
+  m_SampleIdentifiers = NativeIdentifierContainerType::New();
+  m_SampleIdentifiers->CastToSTLContainer() = std::move(sampleIdentifiers);
   this->Modified();
 }
 
 auto
 SWCMeshIO
-::GetSampleIdentifiers() const -> const SampleIdentifierContainerType *
+::GetNativeSampleIdentifiers() const -> const NativeIdentifierContainerType *
+{
+  return m_SampleIdentifiers;
+}
+
+auto
+SWCMeshIO
+::GetNativeSampleIdentifiers() -> NativeIdentifierContainerType *
 {
   return m_SampleIdentifiers;
 }
@@ -736,12 +2125,31 @@ void
 SWCMeshIO
 ::SetTypeIdentifiers(const TypeIdentifierContainerType * typeIdentifiers)
 {
-  const SizeValueType size = typeIdentifiers->Size();
-  m_TypeIdentifiers->resize(size);
-  for (SizeValueType ii = 0; ii < size; ++ii)
+  if (m_TypeIdentifiers != typeIdentifiers)
+  {
+    m_TypeIdentifiers = TypeIdentifierContainerType::New();
+    m_TypeIdentifiers->CastToSTLContainer() = typeIdentifiers->CastToSTLConstContainer();
+    this->Modified();
+  }
+}
+
+void
+SWCMeshIO
+::SetTypeIdentifiers(TypeIdentifierContainerType * typeIdentifiers)
+{
+  if (m_TypeIdentifiers != typeIdentifiers)
   {
-    m_TypeIdentifiers->SetElement(ii, typeIdentifiers->GetElement(ii));
+    m_TypeIdentifiers = typeIdentifiers;
+    this->Modified();
   }
+}
+
+void
+SWCMeshIO
+::SetTypeIdentifiers(TypeIdentifierContainerType::STLContainerType && typeIdentifiers)
+{
+  m_TypeIdentifiers = TypeIdentifierContainerType::New();
+  m_TypeIdentifiers->CastToSTLContainer() = std::move(typeIdentifiers);
   this->Modified();
 }
 
@@ -752,16 +2160,42 @@ SWCMeshIO
   return m_TypeIdentifiers;
 }
 
+auto
+SWCMeshIO
+::GetTypeIdentifiers() -> TypeIdentifierContainerType *
+{
+  return m_TypeIdentifiers;
+}
+
 void
 SWCMeshIO
 ::SetRadii(const RadiusContainerType * radii)
 {
-  const SizeValueType size = radii->Size();
-  m_Radii->resize(size);
-  for (SizeValueType ii = 0; ii < size; ++ii)
+  if (m_Radii != radii)
   {
-    m_Radii->SetElement(ii, radii->GetElement(ii));
+    m_Radii = RadiusContainerType::New();
+    m_Radii->CastToSTLContainer() = radii->CastToSTLConstContainer();
+    this->Modified();
   }
+}
+
+void
+SWCMeshIO
+::SetRadii(RadiusContainerType * radii)
+{
+  if (m_Radii != radii)
+  {
+    m_Radii = radii;
+    this->Modified();
+  }
+}
+
+void
+SWCMeshIO
+::SetRadii(RadiusContainerType::STLContainerType && radii)
+{
+  m_Radii = RadiusContainerType::New();
+  m_Radii->CastToSTLContainer() = std::move(radii);
   this->Modified();
 }
 
@@ -772,22 +2206,75 @@ SWCMeshIO
   return m_Radii;
 }
 
+auto
+SWCMeshIO
+::GetRadii() -> RadiusContainerType *
+{
+  return m_Radii;
+}
+
 void
 SWCMeshIO
 ::SetParentIdentifiers(const ParentIdentifierContainerType * parentIdentifiers)
 {
-  const SizeValueType size = parentIdentifiers->Size();
-  m_ParentIdentifiers->resize(size);
-  for (SizeValueType ii = 0; ii < size; ++ii)
+  const auto & values = parentIdentifiers->CastToSTLConstContainer();
+  m_ParentIdentifiers = NativeIdentifierContainerType::New();
+  m_ParentIdentifiers->CastToSTLContainer().assign(values.begin(), values.end());
+  this->Modified();
+}
+
+auto
+SWCMeshIO
+::GetParentIdentifiers() const -> ParentIdentifierContainerType::ConstPointer
+{
+  const auto & values = m_ParentIdentifiers->CastToSTLConstContainer();
+  auto         parentIdentifiers = ParentIdentifierContainerType::New();
+  parentIdentifiers->CastToSTLContainer().assign(values.begin(), values.end());
+  return parentIdentifiers;
+}
+
+void
+SWCMeshIO
+::SetNativeParentIdentifiers(const NativeIdentifierContainerType * parentIdentifiers)
+{
+  if (m_ParentIdentifiers != parentIdentifiers)
+  {
+    m_ParentIdentifiers = NativeIdentifierContainerType::New();
+    m_ParentIdentifiers->CastToSTLContainer() = parentIdentifiers->CastToSTLConstContainer();
+    this->Modified();
+  }
+}
+
+void
+SWCMeshIO
+::SetNativeParentIdentifiers(NativeIdentifierContainerType * parentIdentifiers)
+{
+  if (m_ParentIdentifiers != parentIdentifiers)
   {
-    m_ParentIdentifiers->SetElement(ii, parentIdentifiers->GetElement(ii));
+    m_ParentIdentifiers = parentIdentifiers;
+    this->Modified();
   }
+}
+
+void
+SWCMeshIO
+::SetNativeParentIdentifiers(NativeIdentifierContainerType::STLContainerType && parentIdentifiers)
+{
+  m_ParentIdentifiers = NativeIdentifierContainerType::New();
+  m_ParentIdentifiers->CastToSTLContainer() = std::move(parentIdentifiers);
   this->Modified();
 }
 
 auto
 SWCMeshIO
-::GetParentIdentifiers() const -> const ParentIdentifierContainerType *
+::GetNativeParentIdentifiers() const -> const NativeIdentifierContainerType *
+{
+  return m_ParentIdentifiers;
+}
+
+auto
+SWCMeshIO
+::GetNativeParentIdentifiers() -> NativeIdentifierContainerType *
 {
   return m_ParentIdentifiers;
 }
@@ -0,0 +1,317 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCMorphometrics.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace itk
+{
+namespace
+{
+// Number of samples whose measures are computed before they are accumulated
+constexpr SizeValueType BlockSize = 1024;
+
+using TypeMeasuresType = SWCMorphometrics::TypeMeasuresType;
+using TypeIdentifierType = SWCMorphometrics::TypeIdentifierType;
+using BoundType = SWCMorphometrics::BoundType;
+
+// Type identifiers that are integers below this bound are looked up in a
+// table. The standard types are 0 to 7, and custom ones rarely exceed 255.
+constexpr unsigned int NumberOfTableTypes = 256;
+
+// Sums over a contiguous range of samples. Types are in order of appearance.
+struct PartialMeasures
+{
+  PartialMeasures() { TypeTable.fill(NoType); }
+
+  static constexpr uint32_t NoType = NumericTraits<uint32_t>::max();
+
+  std::vector<TypeMeasuresType>              TypeMeasures;
+  std::array<uint32_t, NumberOfTableTypes>   TypeTable;
+  BoundType                                  MinimumPoint;
+  BoundType                                  MaximumPoint;
+  double                                     Length{ 0.0 };
+  double                                     SurfaceArea{ 0.0 };
+  double                                     Volume{ 0.0 };
+};
+
+// Index of the measures of typeIdentifier in typeMeasures, added if needed
+uint32_t
+FindTypeMeasures(std::vector<TypeMeasuresType> & typeMeasures, TypeIdentifierType typeIdentifier)
+{
+  for (size_t ii = 0; ii < typeMeasures.size(); ++ii)
+  {
+    if (typeMeasures[ii].TypeIdentifier == typeIdentifier)
+    {
+      return static_cast<uint32_t>(ii);
+    }
+  }
+  typeMeasures.push_back({ typeIdentifier, 0, 0.0, 0.0, 0.0 });
+  return static_cast<uint32_t>(typeMeasures.size() - 1);
+}
+
+// Index of the measures of typeIdentifier in partial.TypeMeasures
+inline uint32_t
+FindTypeMeasures(PartialMeasures & partial, TypeIdentifierType typeIdentifier)
+{
+  // Converting a value outside of the table range, or NaN, is undefined
+  if (typeIdentifier >= 0.0f && typeIdentifier < static_cast<float>(NumberOfTableTypes))
+  {
+    const auto tableIndex = static_cast<unsigned int>(typeIdentifier);
+    if (static_cast<float>(tableIndex) == typeIdentifier)
+    {
+      if (partial.TypeTable[tableIndex] == PartialMeasures::NoType)
+      {
+        partial.TypeTable[tableIndex] = FindTypeMeasures(partial.TypeMeasures, typeIdentifier);
+      }
+      return partial.TypeTable[tableIndex];
+    }
+  }
+  return FindTypeMeasures(partial.TypeMeasures, typeIdentifier);
+}
+
+template <typename TCoordinate>
+void
+AccumulateRange(const TCoordinate *        points,
+                const double *             radii,
+                const TypeIdentifierType * typeIdentifiers,
+                const IdentifierType *     parentPointIndices,
+                SizeValueType              first,
+                SizeValueType              last,
+                PartialMeasures &          partial)
+{
+  partial.MinimumPoint.fill(std::numeric_limits<double>::max());
+  partial.MaximumPoint.fill(std::numeric_limits<double>::lowest());
+
+  double   lengths[BlockSize];
+  double   surfaceAreas[BlockSize];
+  double   volumes[BlockSize];
+  uint32_t typeIndices[BlockSize];
+  for (SizeValueType blockFirst = first; blockFirst < last; blockFirst += BlockSize)
+  {
+    const SizeValueType blockSize = std::min(BlockSize, last - blockFirst);
+    const TCoordinate * blockPoints = points + 3 * blockFirst;
+
+    // A root is its own parent, so that its segment has length zero
+    for (SizeValueType ii = 0; ii < blockSize; ++ii)
+    {
+      const SizeValueType  pointIndex = blockFirst + ii;
+      const IdentifierType parentIndex = parentPointIndices[pointIndex];
+      const SizeValueType  segmentIndex = parentIndex == SWCMorphometrics::InvalidIndex ? pointIndex : parentIndex;
+      const TCoordinate *  point = points + 3 * pointIndex;
+      const TCoordinate *  parentPoint = points + 3 * segmentIndex;
+      const double         dx = static_cast<double>(point[0]) - static_cast<double>(parentPoint[0]);
+      const double         dy = static_cast<double>(point[1]) - static_cast<double>(parentPoint[1]);
+      const double         dz = static_cast<double>(point[2]) - static_cast<double>(parentPoint[2]);
+      const double         squaredLength = dx * dx + dy * dy + dz * dz;
+      const double         radius0 = radii[segmentIndex];
+      const double         radius1 = radii[pointIndex];
+      const double         radiusDifference = radius0 - radius1;
+      lengths[ii] = std::sqrt(squaredLength);
+      surfaceAreas[ii] =
+        Math::pi * (radius0 + radius1) * std::sqrt(radiusDifference * radiusDifference + squaredLength);
+      volumes[ii] = Math::pi / 3.0 * lengths[ii] * (radius0 * radius0 + radius0 * radius1 + radius1 * radius1);
+    }
+
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      double minimum = partial.MinimumPoint[jj];
+      double maximum = partial.MaximumPoint[jj];
+      for (SizeValueType ii = 0; ii < blockSize; ++ii)
+      {
+        const auto coordinate = static_cast<double>(blockPoints[3 * ii + jj]);
+        minimum = std::min(minimum, coordinate);
+        maximum = std::max(maximum, coordinate);
+      }
+      partial.MinimumPoint[jj] = minimum;
+      partial.MaximumPoint[jj] = maximum;
+    }
+
+    for (SizeValueType ii = 0; ii < blockSize; ++ii)
+    {
+      partial.Length += lengths[ii];
+      partial.SurfaceArea += surfaceAreas[ii];
+      partial.Volume += volumes[ii];
+    }
+
+    for (SizeValueType ii = 0; ii < blockSize; ++ii)
+    {
+      typeIndices[ii] = FindTypeMeasures(partial, typeIdentifiers[blockFirst + ii]);
+    }
+    TypeMeasuresType * typeMeasures = partial.TypeMeasures.data();
+    for (SizeValueType ii = 0; ii < blockSize; ++ii)
+    {
+      auto & measures = typeMeasures[typeIndices[ii]];
+      ++measures.NumberOfSamples;
+      measures.Length += lengths[ii];
+      measures.SurfaceArea += surfaceAreas[ii];
+      measures.Volume += volumes[ii];
+    }
+  }
+}
+} // namespace
+
+void
+SWCMorphometrics
+::Compute(const float *              points,
+          const double *             radii,
+          const TypeIdentifierType * typeIdentifiers,
+          const IdentifierType *     parentPointIndices,
+          SizeValueType              numberOfPoints)
+{
+  this->ComputeMeasures(points, radii, typeIdentifiers, parentPointIndices, numberOfPoints);
+}
+
+void
+SWCMorphometrics
+::Compute(const double *             points,
+          const double *             radii,
+          const TypeIdentifierType * typeIdentifiers,
+          const IdentifierType *     parentPointIndices,
+          SizeValueType              numberOfPoints)
+{
+  this->ComputeMeasures(points, radii, typeIdentifiers, parentPointIndices, numberOfPoints);
+}
+
+template <typename TCoordinate>
+void
+SWCMorphometrics
+::ComputeMeasures(const TCoordinate *        points,
+                  const double *             radii,
+                  const TypeIdentifierType * typeIdentifiers,
+                  const IdentifierType *     parentPointIndices,
+                  SizeValueType              numberOfPoints)
+{
+  this->Clear();
+  m_NumberOfSamples = numberOfPoints;
+
+  // Every work unit gets at least a block
+  const SizeValueType numberOfRanges =
+    std::max<SizeValueType>(1, std::min<SizeValueType>(m_NumberOfWorkUnits, numberOfPoints / BlockSize));
+  std::vector<PartialMeasures> partials(numberOfRanges);
+  const auto                   accumulateRange = [&](SizeValueType range) {
+    AccumulateRange(points,
+                    radii,
+                    typeIdentifiers,
+                    parentPointIndices,
+                    range * numberOfPoints / numberOfRanges,
+                    (range + 1) * numberOfPoints / numberOfRanges,
+                    partials[range]);
+  };
+  if (numberOfRanges == 1)
+  {
+    accumulateRange(0);
+  }
+  else
+  {
+    const auto multiThreader = MultiThreaderBase::New();
+    multiThreader->SetMaximumNumberOfThreads(m_NumberOfWorkUnits);
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+    multiThreader->ParallelizeArray(0, numberOfRanges, accumulateRange, nullptr);
+  }
+
+  for (const auto & partial : partials)
+  {
+    m_TotalLength += partial.Length;
+    m_TotalSurfaceArea += partial.SurfaceArea;
+    m_TotalVolume += partial.Volume;
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      m_MinimumPoint[jj] = std::min(m_MinimumPoint[jj], partial.MinimumPoint[jj]);
+      m_MaximumPoint[jj] = std::max(m_MaximumPoint[jj], partial.MaximumPoint[jj]);
+    }
+    for (const auto & partialTypeMeasures : partial.TypeMeasures)
+    {
+      auto & typeMeasures = m_TypeMeasures[FindTypeMeasures(m_TypeMeasures, partialTypeMeasures.TypeIdentifier)];
+      typeMeasures.NumberOfSamples += partialTypeMeasures.NumberOfSamples;
+      typeMeasures.Length += partialTypeMeasures.Length;
+      typeMeasures.SurfaceArea += partialTypeMeasures.SurfaceArea;
+      typeMeasures.Volume += partialTypeMeasures.Volume;
+    }
+  }
+  std::sort(m_TypeMeasures.begin(),
+            m_TypeMeasures.end(),
+            [](const TypeMeasuresType & lhs, const TypeMeasuresType & rhs) {
+              return lhs.TypeIdentifier < rhs.TypeIdentifier;
+            });
+
+  // The children are counted by scattering to the parents, which is not
+  // split across work units
+  std::vector<uint32_t> numberOfChildren(numberOfPoints);
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    const IdentifierType parentIndex = parentPointIndices[ii];
+    if (parentIndex == InvalidIndex)
+    {
+      ++m_NumberOfRoots;
+    }
+    else
+    {
+      ++numberOfChildren[parentIndex];
+    }
+  }
+  for (const auto count : numberOfChildren)
+  {
+    m_NumberOfTips += count == 0;
+    m_NumberOfBranchPoints += count >= 2;
+  }
+}
+
+void
+SWCMorphometrics
+::Clear()
+{
+  m_TypeMeasures.clear();
+  m_MinimumPoint.fill(std::numeric_limits<double>::max());
+  m_MaximumPoint.fill(std::numeric_limits<double>::lowest());
+  m_TotalLength = 0.0;
+  m_TotalSurfaceArea = 0.0;
+  m_TotalVolume = 0.0;
+  m_NumberOfSamples = 0;
+  m_NumberOfRoots = 0;
+  m_NumberOfBranchPoints = 0;
+  m_NumberOfTips = 0;
+}
+
+void
+SWCMorphometrics
+::Print(std::ostream & os) const
+{
+  os << "NumberOfSamples: " << m_NumberOfSamples << '\n'
+     << "NumberOfRoots: " << m_NumberOfRoots << '\n'
+     << "NumberOfBranchPoints: " << m_NumberOfBranchPoints << '\n'
+     << "NumberOfTips: " << m_NumberOfTips << '\n'
+     << "TotalLength: " << m_TotalLength << '\n'
+     << "TotalSurfaceArea: " << m_TotalSurfaceArea << '\n'
+     << "TotalVolume: " << m_TotalVolume << '\n'
+     << "MinimumPoint: " << m_MinimumPoint[0] << ' ' << m_MinimumPoint[1] << ' ' << m_MinimumPoint[2] << '\n'
+     << "MaximumPoint: " << m_MaximumPoint[0] << ' ' << m_MaximumPoint[1] << ' ' << m_MaximumPoint[2] << '\n';
+  for (const auto & typeMeasures : m_TypeMeasures)
+  {
+    os << typeMeasures.TypeIdentifier << '\t' << typeMeasures.NumberOfSamples << '\t' << typeMeasures.Length << '\t'
+       << typeMeasures.SurfaceArea << '\t' << typeMeasures.Volume << '\n';
+  }
+}
+
+} // namespace itk
@@ -0,0 +1,235 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCParsedFileCache.h"
+
+#include "itksys/SystemTools.hxx"
+
+#include <iterator>
+
+namespace itk
+{
+
+namespace
+{
+template <typename T>
+SizeValueType
+VectorSizeInBytes(const std::vector<T> & values)
+{
+  return values.capacity() * sizeof(T);
+}
+
+template <typename TContainer>
+SizeValueType
+ContainerSizeInBytes(const TContainer * container)
+{
+  return container ? VectorSizeInBytes(container->CastToSTLConstContainer()) : 0;
+}
+} // namespace
+
+SizeValueType
+SWCParsedFileCache::EntryType
+::GetSizeInBytes() const
+{
+  SizeValueType sizeInBytes = sizeof(EntryType) + VectorSizeInBytes(HeaderContent);
+  for (const auto & headerLine : HeaderContent)
+  {
+    sizeInBytes += headerLine.capacity();
+  }
+  sizeInBytes += ContainerSizeInBytes(SampleIdentifiers.GetPointer()) +
+                 ContainerSizeInBytes(TypeIdentifiers.GetPointer()) + ContainerSizeInBytes(Points.GetPointer()) +
+                 ContainerSizeInBytes(DoublePoints.GetPointer()) + ContainerSizeInBytes(Radii.GetPointer()) +
+                 ContainerSizeInBytes(ParentIdentifiers.GetPointer()) + ContainerSizeInBytes(Cells.GetPointer()) +
+                 VectorSizeInBytes(PointPermutation);
+  return sizeInBytes;
+}
+
+SWCParsedFileCache &
+SWCParsedFileCache
+::GetInstance()
+{
+  static SWCParsedFileCache instance;
+  return instance;
+}
+
+bool
+SWCParsedFileCache
+::MakeKey(const std::string & readerName, const std::string & fileName, KeyType & key)
+{
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    return false;
+  }
+  key.ReaderName = readerName;
+  key.FileName = itksys::SystemTools::GetRealPath(fileName);
+  key.FileSize = itksys::SystemTools::FileLength(fileName);
+  key.ModifiedTime = itksys::SystemTools::ModifiedTime(fileName);
+  return true;
+}
+
+std::string
+SWCParsedFileCache
+::MakeLookupKey(const KeyType & key)
+{
+  return key.ReaderName + '\n' + key.FileName;
+}
+
+void
+SWCParsedFileCache
+::SetMaximumSizeInBytes(SizeValueType maximumSizeInBytes)
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumSizeInBytes = maximumSizeInBytes;
+  this->EvictToSize(maximumSizeInBytes);
+}
+
+SizeValueType
+SWCParsedFileCache
+::GetMaximumSizeInBytes() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumSizeInBytes;
+}
+
+SWCParsedFileCache::ConstEntryPointer
+SWCParsedFileCache
+::Find(const KeyType & key)
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  const auto it = m_Lookup.find(MakeLookupKey(key));
+  if (it != m_Lookup.end())
+  {
+    const auto item = it->second;
+    if (item->Key.FileSize == key.FileSize && item->Key.ModifiedTime == key.ModifiedTime)
+    {
+      ++m_NumberOfHits;
+      m_Items.splice(m_Items.begin(), m_Items, item);
+      return item->Entry;
+    }
+    // The file changed on disk since it was cached
+    this->Erase(item);
+  }
+  ++m_NumberOfMisses;
+  return nullptr;
+}
+
+void
+SWCParsedFileCache
+::Insert(const KeyType & key, ConstEntryPointer entry)
+{
+  const SizeValueType sizeInBytes = entry->GetSizeInBytes();
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  const std::string lookupKey = MakeLookupKey(key);
+  const auto it = m_Lookup.find(lookupKey);
+  if (it != m_Lookup.end())
+  {
+    this->Erase(it->second);
+  }
+  if (sizeInBytes > m_MaximumSizeInBytes)
+  {
+    return;
+  }
+
+  this->EvictToSize(m_MaximumSizeInBytes - sizeInBytes);
+  m_Items.push_front(ItemType{ key, std::move(entry), sizeInBytes });
+  m_Lookup.emplace(lookupKey, m_Items.begin());
+  m_SizeInBytes += sizeInBytes;
+}
+
+void
+SWCParsedFileCache
+::Clear()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Items.clear();
+  m_Lookup.clear();
+  m_SizeInBytes = 0;
+}
+
+void
+SWCParsedFileCache
+::EvictToSize(SizeValueType sizeInBytes)
+{
+  while (m_SizeInBytes > sizeInBytes)
+  {
+    this->Erase(std::prev(m_Items.end()));
+    ++m_NumberOfEvictions;
+  }
+}
+
+void
+SWCParsedFileCache
+::Erase(ItemListType::iterator item)
+{
+  m_SizeInBytes -= item->SizeInBytes;
+  m_Lookup.erase(MakeLookupKey(item->Key));
+  m_Items.erase(item);
+}
+
+SizeValueType
+SWCParsedFileCache
+::GetSizeInBytes() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_SizeInBytes;
+}
+
+SizeValueType
+SWCParsedFileCache
+::GetNumberOfEntries() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Items.size();
+}
+
+SizeValueType
+SWCParsedFileCache
+::GetNumberOfHits() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfHits;
+}
+
+SizeValueType
+SWCParsedFileCache
+::GetNumberOfMisses() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfMisses;
+}
+
+SizeValueType
+SWCParsedFileCache
+::GetNumberOfEvictions() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfEvictions;
+}
+
+void
+SWCParsedFileCache
+::ResetStatistics()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_NumberOfHits = 0;
+  m_NumberOfMisses = 0;
+  m_NumberOfEvictions = 0;
+}
+
+} // namespace itk
@@ -0,0 +1,604 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCSegmentLocator.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSWCBinaryStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+namespace itk
+{
+namespace
+{
+constexpr char     SegmentLocatorMagic[4] = { 'S', 'W', 'C', 'L' };
+constexpr uint32_t SegmentLocatorVersion = 1;
+
+// Maximum number of segments of a leaf
+constexpr SizeValueType LeafSize = 4;
+
+// Number of segments whose bounds and data are filled per work item
+constexpr SizeValueType BlockSize = 4096;
+
+// Ranges of at most this many segments are built as independent subtrees
+constexpr SizeValueType SubtreeSize = 4096;
+
+// Number of query points of FindNearestSegments handled per work item
+constexpr SizeValueType QueryBlockSize = 256;
+
+// Traversals push both children of a node, so that the stack holds at most
+// one node per level plus one. Trees split at the median are much shallower.
+constexpr unsigned int MaximumDepth = 64;
+constexpr unsigned int MaximumStackSize = MaximumDepth + 1;
+
+using QueryResultType = SWCSegmentLocator::QueryResultType;
+
+using SWCBinaryStream::AddSectionSize;
+using SWCBinaryStream::ReadSection;
+using SWCBinaryStream::ReadValue;
+using SWCBinaryStream::WriteValue;
+
+template <typename T>
+void
+WriteSection(std::ostream & os, const std::vector<T> & data)
+{
+  SWCBinaryStream::WriteSection(os, data.data(), data.size());
+}
+
+// Boxes and centroids of the segments, which the hierarchy is split on
+struct SegmentBounds
+{
+  std::vector<double> Boxes;
+  std::vector<double> Centroids;
+};
+
+// Builds the nodes of the segments indices[begin, end) into nodes. With a
+// non-null subtrees, ranges of at most SubtreeSize segments are left as
+// placeholder nodes and recorded as {node, begin, end} to be built later.
+template <typename TNode>
+class HierarchyBuilder
+{
+public:
+  struct SubtreeType
+  {
+    SizeValueType Node;
+    SizeValueType Begin;
+    SizeValueType End;
+  };
+
+  HierarchyBuilder(const SegmentBounds & bounds, uint64_t * indices)
+    : m_Bounds(bounds)
+    , m_Indices(indices)
+  {}
+
+  void
+  BuildNode(std::vector<TNode> &       nodes,
+            SizeValueType              nodeIndex,
+            SizeValueType              begin,
+            SizeValueType              end,
+            std::vector<SubtreeType> * subtrees) const
+  {
+    double centroidMinimum[3];
+    double centroidMaximum[3];
+    TNode  node;
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      node.Minimum[jj] = centroidMinimum[jj] = std::numeric_limits<double>::max();
+      node.Maximum[jj] = centroidMaximum[jj] = std::numeric_limits<double>::lowest();
+    }
+    for (SizeValueType ii = begin; ii < end; ++ii)
+    {
+      const double * box = m_Bounds.Boxes.data() + 6 * m_Indices[ii];
+      const double * centroid = m_Bounds.Centroids.data() + 3 * m_Indices[ii];
+      for (unsigned int jj = 0; jj < 3; ++jj)
+      {
+        node.Minimum[jj] = std::min(node.Minimum[jj], box[jj]);
+        node.Maximum[jj] = std::max(node.Maximum[jj], box[3 + jj]);
+        centroidMinimum[jj] = std::min(centroidMinimum[jj], centroid[jj]);
+        centroidMaximum[jj] = std::max(centroidMaximum[jj], centroid[jj]);
+      }
+    }
+
+    const SizeValueType numberOfSegments = end - begin;
+    if (numberOfSegments <= LeafSize || (subtrees != nullptr && numberOfSegments <= SubtreeSize))
+    {
+      if (numberOfSegments > LeafSize)
+      {
+        subtrees->push_back({ nodeIndex, begin, end });
+      }
+      node.First = begin;
+      node.Count = numberOfSegments;
+      nodes[nodeIndex] = node;
+      return;
+    }
+
+    unsigned int axis = 0;
+    for (unsigned int jj = 1; jj < 3; ++jj)
+    {
+      if (centroidMaximum[jj] - centroidMinimum[jj] > centroidMaximum[axis] - centroidMinimum[axis])
+      {
+        axis = jj;
+      }
+    }
+    const SizeValueType middle = begin + numberOfSegments / 2;
+    const double *      centroids = m_Bounds.Centroids.data();
+    std::nth_element(
+      m_Indices + begin, m_Indices + middle, m_Indices + end, [centroids, axis](uint64_t lhs, uint64_t rhs) {
+        const double lhsCentroid = centroids[3 * lhs + axis];
+        const double rhsCentroid = centroids[3 * rhs + axis];
+        return lhsCentroid < rhsCentroid || (lhsCentroid == rhsCentroid && lhs < rhs);
+      });
+
+    const SizeValueType children = nodes.size();
+    node.First = children;
+    node.Count = 0;
+    nodes[nodeIndex] = node;
+    nodes.resize(children + 2);
+    this->BuildNode(nodes, children, begin, middle, subtrees);
+    this->BuildNode(nodes, children + 1, middle, end, subtrees);
+  }
+
+private:
+  const SegmentBounds & m_Bounds;
+  uint64_t *            m_Indices;
+};
+
+// Squared distance from point to the box of node
+template <typename TNode>
+inline double
+SquaredBoxDistance(const SWCSegmentLocator::PointType & point, const TNode & node)
+{
+  double squaredDistance = 0.0;
+  for (unsigned int jj = 0; jj < 3; ++jj)
+  {
+    const double difference =
+      std::max(0.0, std::max(node.Minimum[jj] - point[jj], point[jj] - node.Maximum[jj]));
+    squaredDistance += difference * difference;
+  }
+  return squaredDistance;
+}
+
+inline bool
+IsCloser(const QueryResultType & lhs, const QueryResultType & rhs)
+{
+  if (lhs.Distance != rhs.Distance)
+  {
+    return lhs.Distance < rhs.Distance;
+  }
+  if (lhs.AxisDistance != rhs.AxisDistance)
+  {
+    return lhs.AxisDistance < rhs.AxisDistance;
+  }
+  return lhs.PointIndex < rhs.PointIndex;
+}
+} // namespace
+
+void
+SWCSegmentLocator
+::Build(const float *          points,
+        const double *         radii,
+        const IdentifierType * parentPointIndices,
+        SizeValueType          numberOfPoints)
+{
+  this->BuildHierarchy(points, radii, parentPointIndices, numberOfPoints);
+}
+
+void
+SWCSegmentLocator
+::Build(const double *         points,
+        const double *         radii,
+        const IdentifierType * parentPointIndices,
+        SizeValueType          numberOfPoints)
+{
+  this->BuildHierarchy(points, radii, parentPointIndices, numberOfPoints);
+}
+
+template <typename TCoordinate>
+void
+SWCSegmentLocator
+::BuildHierarchy(const TCoordinate *    points,
+                 const double *         radii,
+                 const IdentifierType * parentPointIndices,
+                 SizeValueType          numberOfPoints)
+{
+  this->Clear();
+  if (numberOfPoints == 0)
+  {
+    return;
+  }
+
+  const auto multiThreader = MultiThreaderBase::New();
+  multiThreader->SetMaximumNumberOfThreads(m_NumberOfWorkUnits);
+  multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  const auto parallelize = [&](SizeValueType size, const std::function<void(SizeValueType)> & function) {
+    if (m_NumberOfWorkUnits == 1 || size == 1)
+    {
+      for (SizeValueType ii = 0; ii < size; ++ii)
+      {
+        function(ii);
+      }
+    }
+    else
+    {
+      multiThreader->ParallelizeArray(0, size, function, nullptr);
+    }
+  };
+
+  // A root is its own parent, so that its segment is a sphere
+  const auto segmentParent = [parentPointIndices](SizeValueType pointIndex) -> SizeValueType {
+    const IdentifierType parentIndex = parentPointIndices[pointIndex];
+    return parentIndex == InvalidIndex ? pointIndex : parentIndex;
+  };
+
+  SegmentBounds bounds;
+  bounds.Boxes.resize(6 * numberOfPoints);
+  bounds.Centroids.resize(3 * numberOfPoints);
+  const SizeValueType numberOfBlocks = (numberOfPoints + BlockSize - 1) / BlockSize;
+  parallelize(numberOfBlocks, [&](SizeValueType block) {
+    const SizeValueType last = std::min(numberOfPoints, (block + 1) * BlockSize);
+    for (SizeValueType ii = block * BlockSize; ii < last; ++ii)
+    {
+      const SizeValueType parentIndex = segmentParent(ii);
+      const double        radius = std::max(radii[ii], radii[parentIndex]);
+      double *            box = bounds.Boxes.data() + 6 * ii;
+      for (unsigned int jj = 0; jj < 3; ++jj)
+      {
+        const auto coordinate = static_cast<double>(points[3 * ii + jj]);
+        const auto parentCoordinate = static_cast<double>(points[3 * parentIndex + jj]);
+        box[jj] = std::min(coordinate, parentCoordinate) - radius;
+        box[3 + jj] = std::max(coordinate, parentCoordinate) + radius;
+        bounds.Centroids[3 * ii + jj] = 0.5 * (coordinate + parentCoordinate);
+      }
+    }
+  });
+
+  std::vector<uint64_t> indices(numberOfPoints);
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    indices[ii] = ii;
+  }
+
+  using BuilderType = HierarchyBuilder<NodeType>;
+  const BuilderType                      builder(bounds, indices.data());
+  std::vector<BuilderType::SubtreeType> subtrees;
+  m_Nodes.resize(1);
+  builder.BuildNode(m_Nodes, 0, 0, numberOfPoints, &subtrees);
+
+  // The subtrees only touch their own range of indices, and are appended in
+  // order so that the layout does not depend on the number of work units
+  std::vector<std::vector<NodeType>> subtreeNodes(subtrees.size());
+  parallelize(subtrees.size(), [&](SizeValueType subtree) {
+    subtreeNodes[subtree].resize(1);
+    builder.BuildNode(subtreeNodes[subtree], 0, subtrees[subtree].Begin, subtrees[subtree].End, nullptr);
+  });
+  for (SizeValueType subtree = 0; subtree < subtrees.size(); ++subtree)
+  {
+    auto &         nodes = subtreeNodes[subtree];
+    const uint64_t offset = m_Nodes.size() - 1;
+    for (auto & node : nodes)
+    {
+      if (node.Count == 0)
+      {
+        node.First += offset;
+      }
+    }
+    m_Nodes[subtrees[subtree].Node] = nodes[0];
+    m_Nodes.insert(m_Nodes.end(), nodes.begin() + 1, nodes.end());
+    std::vector<NodeType>().swap(nodes);
+  }
+
+  m_SegmentPoints.resize(6 * numberOfPoints);
+  m_SegmentRadii.resize(2 * numberOfPoints);
+  m_SegmentPointIndices.resize(numberOfPoints);
+  parallelize(numberOfBlocks, [&](SizeValueType block) {
+    const SizeValueType last = std::min(numberOfPoints, (block + 1) * BlockSize);
+    for (SizeValueType ii = block * BlockSize; ii < last; ++ii)
+    {
+      const SizeValueType pointIndex = indices[ii];
+      const SizeValueType parentIndex = segmentParent(pointIndex);
+      for (unsigned int jj = 0; jj < 3; ++jj)
+      {
+        m_SegmentPoints[6 * ii + jj] = static_cast<double>(points[3 * pointIndex + jj]);
+        m_SegmentPoints[6 * ii + 3 + jj] = static_cast<double>(points[3 * parentIndex + jj]);
+      }
+      m_SegmentRadii[2 * ii] = radii[pointIndex];
+      m_SegmentRadii[2 * ii + 1] = radii[parentIndex];
+      m_SegmentPointIndices[ii] = pointIndex;
+    }
+  });
+}
+
+void
+SWCSegmentLocator
+::Clear()
+{
+  m_Nodes.clear();
+  m_SegmentPoints.clear();
+  m_SegmentRadii.clear();
+  m_SegmentPointIndices.clear();
+}
+
+QueryResultType
+SWCSegmentLocator
+::ComputeSegmentDistance(const PointType & point, SizeValueType segment) const
+{
+  const double * segmentPoint = m_SegmentPoints.data() + 6 * segment;
+  const double * parentPoint = segmentPoint + 3;
+  double         direction[3];
+  double         offset[3];
+  double         squaredLength = 0.0;
+  double         projection = 0.0;
+  for (unsigned int jj = 0; jj < 3; ++jj)
+  {
+    direction[jj] = parentPoint[jj] - segmentPoint[jj];
+    offset[jj] = point[jj] - segmentPoint[jj];
+    squaredLength += direction[jj] * direction[jj];
+    projection += direction[jj] * offset[jj];
+  }
+  const double parameter = squaredLength > 0.0 ? std::min(1.0, std::max(0.0, projection / squaredLength)) : 0.0;
+  double       squaredAxisDistance = 0.0;
+  for (unsigned int jj = 0; jj < 3; ++jj)
+  {
+    const double difference = offset[jj] - parameter * direction[jj];
+    squaredAxisDistance += difference * difference;
+  }
+  const double axisDistance = std::sqrt(squaredAxisDistance);
+  const double * radii = m_SegmentRadii.data() + 2 * segment;
+  const double   radius = radii[0] + parameter * (radii[1] - radii[0]);
+  return { m_SegmentPointIndices[segment], std::max(0.0, axisDistance - radius), axisDistance, parameter };
+}
+
+void
+SWCSegmentLocator
+::UpdateNearestSegment(const PointType & point, SizeValueType segment, QueryResultType & result) const
+{
+  const QueryResultType candidate = this->ComputeSegmentDistance(point, segment);
+  if (IsCloser(candidate, result))
+  {
+    result = candidate;
+  }
+}
+
+bool
+SWCSegmentLocator
+::FindNearestSegment(const PointType & point, QueryResultType & result) const
+{
+  result = { InvalidIndex, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), 0.0 };
+  if (m_Nodes.empty())
+  {
+    return false;
+  }
+
+  // The box of a node contains its segments, so its distance bounds theirs
+  uint64_t     stack[MaximumStackSize];
+  unsigned int stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0)
+  {
+    const NodeType & node = m_Nodes[stack[--stackSize]];
+    if (SquaredBoxDistance(point, node) > result.Distance * result.Distance)
+    {
+      continue;
+    }
+    if (node.Count > 0)
+    {
+      for (uint64_t segment = node.First; segment < node.First + node.Count; ++segment)
+      {
+        this->UpdateNearestSegment(point, segment, result);
+      }
+      continue;
+    }
+
+    // The closer child is visited first
+    const double firstDistance = SquaredBoxDistance(point, m_Nodes[node.First]);
+    const double secondDistance = SquaredBoxDistance(point, m_Nodes[node.First + 1]);
+    if (firstDistance <= secondDistance)
+    {
+      stack[stackSize++] = node.First + 1;
+      stack[stackSize++] = node.First;
+    }
+    else
+    {
+      stack[stackSize++] = node.First;
+      stack[stackSize++] = node.First + 1;
+    }
+  }
+  return true;
+}
+
+void
+SWCSegmentLocator
+::FindNearestSegments(const double * points, SizeValueType numberOfPoints, QueryResultType * results) const
+{
+  const auto findBlock = [&](SizeValueType block) {
+    const SizeValueType last = std::min(numberOfPoints, (block + 1) * QueryBlockSize);
+    for (SizeValueType ii = block * QueryBlockSize; ii < last; ++ii)
+    {
+      this->FindNearestSegment({ points[3 * ii], points[3 * ii + 1], points[3 * ii + 2] }, results[ii]);
+    }
+  };
+  const SizeValueType numberOfBlocks = (numberOfPoints + QueryBlockSize - 1) / QueryBlockSize;
+  if (m_NumberOfWorkUnits == 1 || numberOfBlocks <= 1)
+  {
+    for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+    {
+      findBlock(block);
+    }
+  }
+  else
+  {
+    const auto multiThreader = MultiThreaderBase::New();
+    multiThreader->SetMaximumNumberOfThreads(m_NumberOfWorkUnits);
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+    multiThreader->ParallelizeArray(0, numberOfBlocks, findBlock, nullptr);
+  }
+}
+
+void
+SWCSegmentLocator
+::FindSegmentsWithinDistance(const PointType & point, double distance, QueryResultContainerType & results) const
+{
+  results.clear();
+  if (m_Nodes.empty() || !(distance >= 0.0))
+  {
+    return;
+  }
+
+  const double squaredDistance = distance * distance;
+  uint64_t     stack[MaximumStackSize];
+  unsigned int stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0)
+  {
+    const NodeType & node = m_Nodes[stack[--stackSize]];
+    if (SquaredBoxDistance(point, node) > squaredDistance)
+    {
+      continue;
+    }
+    if (node.Count > 0)
+    {
+      for (uint64_t segment = node.First; segment < node.First + node.Count; ++segment)
+      {
+        const QueryResultType candidate = this->ComputeSegmentDistance(point, segment);
+        if (candidate.Distance <= distance)
+        {
+          results.push_back(candidate);
+        }
+      }
+      continue;
+    }
+    stack[stackSize++] = node.First + 1;
+    stack[stackSize++] = node.First;
+  }
+  std::sort(results.begin(), results.end(), [](const QueryResultType & lhs, const QueryResultType & rhs) {
+    return lhs.PointIndex < rhs.PointIndex;
+  });
+}
+
+void
+SWCSegmentLocator
+::Write(std::ostream & os) const
+{
+  const SizeValueType numberOfNodes = m_Nodes.size();
+  std::vector<double>   nodeBounds(6 * numberOfNodes);
+  std::vector<uint64_t> nodeRanges(2 * numberOfNodes);
+  for (SizeValueType ii = 0; ii < numberOfNodes; ++ii)
+  {
+    std::copy_n(m_Nodes[ii].Minimum, 3, nodeBounds.begin() + 6 * ii);
+    std::copy_n(m_Nodes[ii].Maximum, 3, nodeBounds.begin() + 6 * ii + 3);
+    nodeRanges[2 * ii] = m_Nodes[ii].First;
+    nodeRanges[2 * ii + 1] = m_Nodes[ii].Count;
+  }
+  const std::vector<uint64_t> pointIndices(m_SegmentPointIndices.begin(), m_SegmentPointIndices.end());
+
+  os.write(SegmentLocatorMagic, sizeof(SegmentLocatorMagic));
+  WriteValue<uint32_t>(os, SegmentLocatorVersion);
+  WriteValue<uint64_t>(os, m_SegmentPointIndices.size());
+  WriteValue<uint64_t>(os, numberOfNodes);
+  WriteSection(os, nodeBounds);
+  WriteSection(os, nodeRanges);
+  WriteSection(os, m_SegmentPoints);
+  WriteSection(os, m_SegmentRadii);
+  WriteSection(os, pointIndices);
+  if (!os)
+  {
+    itkGenericExceptionMacro("Failed to write SWCSegmentLocator");
+  }
+}
+
+void
+SWCSegmentLocator
+::Read(std::istream & is)
+{
+  this->Clear();
+
+  char magic[sizeof(SegmentLocatorMagic)];
+  if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, SegmentLocatorMagic, sizeof(magic)) != 0)
+  {
+    itkGenericExceptionMacro("Not an SWCSegmentLocator stream");
+  }
+  const auto version = ReadValue<uint32_t>(is);
+  if (version != SegmentLocatorVersion)
+  {
+    itkGenericExceptionMacro("Unsupported SWCSegmentLocator version " << version);
+  }
+  const auto numberOfSegments = ReadValue<uint64_t>(is);
+  const auto numberOfNodes = ReadValue<uint64_t>(is);
+  if (!is || numberOfNodes > 2 * numberOfSegments || (numberOfNodes == 0) != (numberOfSegments == 0))
+  {
+    itkGenericExceptionMacro("Invalid SWCSegmentLocator header");
+  }
+
+  // The sections are sized from the header counts, so check that the stream
+  // holds them before allocating them
+  uint64_t sectionsLength = 0;
+  if (!AddSectionSize(sectionsLength, numberOfNodes, 6 * sizeof(double)) ||
+      !AddSectionSize(sectionsLength, numberOfNodes, 2 * sizeof(uint64_t)) ||
+      !AddSectionSize(sectionsLength, numberOfSegments, 6 * sizeof(double)) ||
+      !AddSectionSize(sectionsLength, numberOfSegments, 2 * sizeof(double)) ||
+      !AddSectionSize(sectionsLength, numberOfSegments, sizeof(uint64_t)) ||
+      sectionsLength > SWCBinaryStream::GetRemainingLength(is))
+  {
+    itkGenericExceptionMacro("Unexpected end of SWCSegmentLocator stream");
+  }
+
+  std::vector<double>   nodeBounds;
+  std::vector<uint64_t> nodeRanges;
+  std::vector<uint64_t> pointIndices;
+  ReadSection(is, nodeBounds, 6 * numberOfNodes);
+  ReadSection(is, nodeRanges, 2 * numberOfNodes);
+  ReadSection(is, m_SegmentPoints, 6 * numberOfSegments);
+  ReadSection(is, m_SegmentRadii, 2 * numberOfSegments);
+  ReadSection(is, pointIndices, numberOfSegments);
+  if (!is)
+  {
+    this->Clear();
+    itkGenericExceptionMacro("Unexpected end of SWCSegmentLocator stream");
+  }
+
+  // Children follow their parent, so that queries terminate, and the depth
+  // is bounded by the traversal stack
+  std::vector<unsigned int> depths(numberOfNodes);
+  m_Nodes.resize(numberOfNodes);
+  for (SizeValueType ii = 0; ii < numberOfNodes; ++ii)
+  {
+    auto & node = m_Nodes[ii];
+    std::copy_n(nodeBounds.begin() + 6 * ii, 3, node.Minimum);
+    std::copy_n(nodeBounds.begin() + 6 * ii + 3, 3, node.Maximum);
+    node.First = nodeRanges[2 * ii];
+    node.Count = nodeRanges[2 * ii + 1];
+    const bool isValid = node.Count == 0 ? node.First > ii && node.First + 1 < numberOfNodes
+                                         : node.First < numberOfSegments && node.Count <= numberOfSegments - node.First;
+    if (isValid && node.Count == 0)
+    {
+      depths[node.First] = depths[node.First + 1] = depths[ii] + 1;
+    }
+    if (!isValid || depths[ii] >= MaximumDepth)
+    {
+      this->Clear();
+      itkGenericExceptionMacro("Invalid SWCSegmentLocator node " << ii);
+    }
+  }
+  m_SegmentPointIndices.assign(pointIndices.begin(), pointIndices.end());
+}
+
+} // namespace itk
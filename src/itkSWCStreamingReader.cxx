@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCStreamingReader.h"
+#include "itkSWCFileStream.h"
+
+namespace itk
+{
+
+void
+SWCStreamingReader
+::Update()
+{
+  SWCInputFileStream inputFile;
+  if (!inputFile.Open(m_FileName))
+  {
+    itkExceptionMacro(<< "Unable to open input file " << m_FileName);
+  }
+
+  m_NumberOfSamples = 0;
+  m_NumberOfLines = 0;
+
+  SWCParser::SampleBuffers batch;
+  batch.SampleIdentifiers.reserve(m_BatchSize);
+  batch.TypeIdentifiers.reserve(m_BatchSize);
+  batch.Points.reserve(3 * m_BatchSize);
+  batch.Radii.reserve(m_BatchSize);
+  batch.ParentIdentifiers.reserve(m_BatchSize);
+  std::string headerLine;
+
+  const auto flushBatch = [this, &batch]() {
+    if (batch.Size() > 0)
+    {
+      if (m_SampleBatchCallback)
+      {
+        m_SampleBatchCallback(batch, m_NumberOfSamples);
+      }
+      m_NumberOfSamples += batch.Size();
+      batch.Clear();
+    }
+  };
+
+  std::vector<char> blockBuffer;
+  const auto        read = [&inputFile](char * destination, size_t count) {
+    return inputFile.Read(destination, count);
+  };
+  SWCParser::ForEachBlock(read, blockBuffer, SWCParser::DefaultBlockSize, [&](const char * first, const char * last) {
+    while (first != last)
+    {
+      const char * lineEnd = SWCParser::FindLineEnd(first, last);
+      ++m_NumberOfLines;
+      const char * commentFirst = nullptr;
+      const char * commentLast = nullptr;
+      switch (SWCParser::ParseLine(first, lineEnd, batch, commentFirst, commentLast))
+      {
+        case SWCParser::LineStatus::Comment:
+          if (m_HeaderLineCallback)
+          {
+            headerLine.assign(commentFirst, commentLast);
+            m_HeaderLineCallback(headerLine);
+          }
+          break;
+        case SWCParser::LineStatus::Sample:
+          if (batch.Size() == m_BatchSize)
+          {
+            flushBatch();
+          }
+          break;
+        case SWCParser::LineStatus::Invalid:
+          if (inputFile.HasError())
+          {
+            itkExceptionMacro(<< "Unable to decompress input file " << m_FileName);
+          }
+          flushBatch();
+          itkExceptionMacro(<< "Invalid SWC sample on line " << m_NumberOfLines << " of " << m_FileName);
+        default:
+          break;
+      }
+      first = lineEnd == last ? last : lineEnd + 1;
+    }
+  });
+  flushBatch();
+  inputFile.Close();
+  if (inputFile.HasError())
+  {
+    itkExceptionMacro(<< "Unable to decompress input file " << m_FileName);
+  }
+}
+
+void
+SWCStreamingReader
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "BatchSize: " << m_BatchSize << std::endl;
+  os << indent << "NumberOfSamples: " << m_NumberOfSamples << std::endl;
+  os << indent << "NumberOfLines: " << m_NumberOfLines << std::endl;
+}
+
+} // namespace itk
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCTopology.h"
+
+namespace itk
+{
+
+void
+SWCTopology
+::Build(const IdentifierValueType * parentIdentifiers,
+        SizeValueType               numberOfPoints,
+        const SWCIdentifierIndex &  sampleIdentifierIndex)
+{
+  this->Clear();
+  m_ParentPointIndices.resize(numberOfPoints);
+  m_ChildOffsets.assign(numberOfPoints + 1, 0);
+
+  // Count the children of every point, then turn the counts into offsets
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    const auto parentIdentifier = parentIdentifiers[ii];
+    const auto parentIndex = parentIdentifier != -1 ? sampleIdentifierIndex.Find(parentIdentifier) : InvalidIndex;
+    m_ParentPointIndices[ii] = parentIndex;
+    if (parentIndex == InvalidIndex)
+    {
+      m_RootPointIndices.push_back(ii);
+    }
+    else
+    {
+      ++m_ChildOffsets[parentIndex + 1];
+    }
+  }
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    m_ChildOffsets[ii + 1] += m_ChildOffsets[ii];
+    if (m_ChildOffsets[ii + 1] == m_ChildOffsets[ii])
+    {
+      m_LeafPointIndices.push_back(ii);
+    }
+  }
+
+  // Scatter the children, in ascending order since points are visited in order
+  m_ChildPointIndices.resize(m_ChildOffsets[numberOfPoints]);
+  IndexContainerType nextChild(m_ChildOffsets.begin(), m_ChildOffsets.end() - 1);
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    const auto parentIndex = m_ParentPointIndices[ii];
+    if (parentIndex != InvalidIndex)
+    {
+      m_ChildPointIndices[nextChild[parentIndex]++] = ii;
+    }
+  }
+}
+
+void
+SWCTopology
+::Clear()
+{
+  m_ParentPointIndices.clear();
+  m_ChildOffsets.clear();
+  m_ChildPointIndices.clear();
+  m_RootPointIndices.clear();
+  m_LeafPointIndices.clear();
+}
+
+void
+SWCTopology
+::DepthFirstOrder(IndexContainerType & order) const
+{
+  order.clear();
+  order.reserve(this->GetNumberOfPoints());
+
+  // Children are pushed in reverse so that the smallest index is visited first
+  IndexContainerType stack(m_RootPointIndices.rbegin(), m_RootPointIndices.rend());
+  while (!stack.empty())
+  {
+    const IdentifierType pointIndex = stack.back();
+    stack.pop_back();
+    order.push_back(pointIndex);
+    for (auto child = this->EndChildren(pointIndex); child != this->BeginChildren(pointIndex);)
+    {
+      stack.push_back(*--child);
+    }
+  }
+}
+
+void
+SWCTopology
+::BreadthFirstOrder(IndexContainerType & order) const
+{
+  // order doubles as the queue
+  order.assign(m_RootPointIndices.begin(), m_RootPointIndices.end());
+  order.reserve(this->GetNumberOfPoints());
+  for (SizeValueType head = 0; head < order.size(); ++head)
+  {
+    const IdentifierType pointIndex = order[head];
+    order.insert(order.end(), this->BeginChildren(pointIndex), this->EndChildren(pointIndex));
+  }
+}
+
+} // namespace itk
@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCValidationReport.h"
+
+namespace itk
+{
+
+std::ostream &
+operator<<(std::ostream & out, const SWCValidationReport::ErrorCode value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case SWCValidationReport::ErrorCode::MissingParent:
+        return "MissingParent";
+      case SWCValidationReport::ErrorCode::DuplicateIdentifier:
+        return "DuplicateIdentifier";
+      case SWCValidationReport::ErrorCode::MultipleRoots:
+        return "MultipleRoots";
+      case SWCValidationReport::ErrorCode::Cycle:
+        return "Cycle";
+      default:
+        return "INVALID VALUE FOR SWCValidationReport::ErrorCode";
+    }
+  }();
+}
+
+void
+SWCValidationReport
+::Compute(const IdentifierValueType * sampleIdentifiers,
+          const IdentifierValueType * parentIdentifiers,
+          SizeValueType               numberOfPoints,
+          const SWCIdentifierIndex &  sampleIdentifierIndex,
+          const SizeValueType *       lineNumbers)
+{
+  this->Clear();
+  m_NumberOfSamples = numberOfPoints;
+
+  // Resolve the parents once. The index keeps the last occurrence of an
+  // identifier, so any other occurrence is a duplicate.
+  std::vector<IdentifierType> parentPointIndices(numberOfPoints, SWCIdentifierIndex::InvalidIndex);
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    if (sampleIdentifierIndex.Find(sampleIdentifiers[ii]) != ii)
+    {
+      ++m_NumberOfDuplicateIdentifiers;
+      this->AddIssue(ErrorCode::DuplicateIdentifier, ii, sampleIdentifiers, parentIdentifiers, lineNumbers);
+    }
+
+    if (parentIdentifiers[ii] == -1)
+    {
+      if (++m_NumberOfRoots > 1)
+      {
+        this->AddIssue(ErrorCode::MultipleRoots, ii, sampleIdentifiers, parentIdentifiers, lineNumbers);
+      }
+      continue;
+    }
+    parentPointIndices[ii] = sampleIdentifierIndex.Find(parentIdentifiers[ii]);
+    if (parentPointIndices[ii] == SWCIdentifierIndex::InvalidIndex)
+    {
+      ++m_NumberOfMissingParents;
+      this->AddIssue(ErrorCode::MissingParent, ii, sampleIdentifiers, parentIdentifiers, lineNumbers);
+    }
+  }
+
+  // Every point has at most one parent, so following the parent links from
+  // each unvisited point either ends at a root, at a point already checked,
+  // or at a point of the current path, which then closes a cycle.
+  enum : uint8_t
+  {
+    Unvisited,
+    OnPath,
+    Checked
+  };
+  std::vector<uint8_t> states(numberOfPoints, Unvisited);
+  for (SizeValueType first = 0; first < numberOfPoints; ++first)
+  {
+    IdentifierType pointIndex = first;
+    while (pointIndex != SWCIdentifierIndex::InvalidIndex && states[pointIndex] == Unvisited)
+    {
+      states[pointIndex] = OnPath;
+      pointIndex = parentPointIndices[pointIndex];
+    }
+    if (pointIndex != SWCIdentifierIndex::InvalidIndex && states[pointIndex] == OnPath)
+    {
+      ++m_NumberOfCycles;
+      this->AddIssue(ErrorCode::Cycle, pointIndex, sampleIdentifiers, parentIdentifiers, lineNumbers);
+      IdentifierType cycleIndex = pointIndex;
+      do
+      {
+        ++m_NumberOfPointsOnCycles;
+        cycleIndex = parentPointIndices[cycleIndex];
+      } while (cycleIndex != pointIndex);
+    }
+    for (pointIndex = first; pointIndex != SWCIdentifierIndex::InvalidIndex && states[pointIndex] == OnPath;
+         pointIndex = parentPointIndices[pointIndex])
+    {
+      states[pointIndex] = Checked;
+    }
+  }
+}
+
+void
+SWCValidationReport
+::AddIssue(ErrorCode                   code,
+           SizeValueType               pointIndex,
+           const IdentifierValueType * sampleIdentifiers,
+           const IdentifierValueType * parentIdentifiers,
+           const SizeValueType *       lineNumbers)
+{
+  ++m_NumberOfIssues;
+  if (m_Issues.size() < m_MaximumNumberOfIssues)
+  {
+    m_Issues.push_back(IssueType{ code,
+                                  pointIndex,
+                                  lineNumbers ? lineNumbers[pointIndex] : 0,
+                                  sampleIdentifiers[pointIndex],
+                                  parentIdentifiers[pointIndex] });
+  }
+}
+
+void
+SWCValidationReport
+::Clear()
+{
+  m_Issues.clear();
+  m_NumberOfIssues = 0;
+  m_NumberOfSamples = 0;
+  m_NumberOfRoots = 0;
+  m_NumberOfMissingParents = 0;
+  m_NumberOfDuplicateIdentifiers = 0;
+  m_NumberOfCycles = 0;
+  m_NumberOfPointsOnCycles = 0;
+}
+
+void
+SWCValidationReport
+::Print(std::ostream & os) const
+{
+  os << "NumberOfSamples: " << m_NumberOfSamples << '\n'
+     << "NumberOfIssues: " << m_NumberOfIssues << '\n'
+     << "NumberOfRoots: " << m_NumberOfRoots << '\n'
+     << "NumberOfMissingParents: " << m_NumberOfMissingParents << '\n'
+     << "NumberOfDuplicateIdentifiers: " << m_NumberOfDuplicateIdentifiers << '\n'
+     << "NumberOfCycles: " << m_NumberOfCycles << '\n'
+     << "NumberOfPointsOnCycles: " << m_NumberOfPointsOnCycles << '\n';
+  for (const auto & issue : m_Issues)
+  {
+    os << issue.Code << '\t' << issue.LineNumber << '\t' << issue.PointIndex << '\t' << issue.SampleIdentifier << '\t'
+       << issue.ParentIdentifier << '\n';
+  }
+}
+
+} // namespace itk
@@ -75,10 +75,22 @@ itkMeshFileReadWriteTest(int argc, char * argv[])
     }
 
     swcMeshIOOutput->SetSampleIdentifiers(swcMeshIO->GetSampleIdentifiers());
+    swcMeshIOOutput->SetParentIdentifiers(swcMeshIO->GetParentIdentifiers());
+
+    // The native identifiers, the types and the radii are shared, not copied
+    swcMeshIOOutput->SetNativeSampleIdentifiers(swcMeshIO->GetNativeSampleIdentifiers());
     swcMeshIOOutput->SetTypeIdentifiers(swcMeshIO->GetTypeIdentifiers());
     swcMeshIOOutput->SetRadii(swcMeshIO->GetRadii());
-    swcMeshIOOutput->SetParentIdentifiers(swcMeshIO->GetParentIdentifiers());
+    swcMeshIOOutput->SetNativeParentIdentifiers(swcMeshIO->GetNativeParentIdentifiers());
     swcMeshIOOutput->SetHeaderContent(swcMeshIO->GetHeaderContent());
+    if (swcMeshIOOutput->GetNativeSampleIdentifiers() != swcMeshIO->GetNativeSampleIdentifiers() ||
+        swcMeshIOOutput->GetTypeIdentifiers() != swcMeshIO->GetTypeIdentifiers() ||
+        swcMeshIOOutput->GetRadii() != swcMeshIO->GetRadii() ||
+        swcMeshIOOutput->GetNativeParentIdentifiers() != swcMeshIO->GetNativeParentIdentifiers())
+    {
+      std::cerr << "The attribute containers were copied instead of shared.";
+      result = EXIT_FAILURE;
+    }
   }
 
   std::cout << "Test finished." << std::endl;
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCBatchReader.h"
+#include "itkSWCMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+int
+itkSWCBatchReaderTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // Files of varying size, with one invalid file in the middle
+  constexpr unsigned int   numberOfFiles = 12;
+  constexpr unsigned int   invalidFile = 5;
+  std::vector<std::string> fileNames;
+  for (unsigned int ii = 0; ii < numberOfFiles; ++ii)
+  {
+    const std::string fileName =
+      outputDirectory + "/itkSWCBatchReaderTest" + (ii < 10 ? "0" : "") + std::to_string(ii) + ".swc";
+    std::ofstream outputFile(fileName.c_str(), std::ios::out);
+    outputFile << "# file " << ii << '\n';
+    for (unsigned int jj = 1; jj <= 10 * ii + 1; ++jj)
+    {
+      outputFile << jj << " 3 " << ii << ' ' << jj << " 0 " << 0.5 * jj << ' ' << static_cast<int>(jj) - 1 << '\n';
+    }
+    if (ii == invalidFile)
+    {
+      outputFile << "99 3 0 0\n";
+    }
+    fileNames.push_back(fileName);
+  }
+  const std::string missingFileName = outputDirectory + "/itkSWCBatchReaderTestMissing.swc";
+
+  auto batchReader = itk::SWCBatchReader::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(batchReader, SWCBatchReader, Object);
+
+  batchReader->SetNumberOfWorkUnits(3);
+  ITK_TEST_SET_GET_VALUE(3, batchReader->GetNumberOfWorkUnits());
+  const std::string pattern = outputDirectory + "/itkSWCBatchReaderTest[0-9][0-9].swc";
+  ITK_TEST_EXPECT_EQUAL(batchReader->AddFileNamesFromGlob(pattern), numberOfFiles);
+  ITK_TEST_EXPECT_TRUE(batchReader->GetFileNames() == fileNames);
+  batchReader->AddFileName(missingFileName);
+  batchReader->Update();
+
+  // Records come back in input order and failures do not abort the batch
+  ITK_TEST_EXPECT_EQUAL(batchReader->GetNumberOfRecords(), numberOfFiles + 1);
+  ITK_TEST_EXPECT_EQUAL(batchReader->GetNumberOfFailures(), 2);
+  ITK_TEST_EXPECT_TRUE(!batchReader->GetRecord(invalidFile).Succeeded);
+  ITK_TEST_EXPECT_TRUE(batchReader->GetRecord(invalidFile).ErrorMessage.find("line 53") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(!batchReader->GetRecord(numberOfFiles).Succeeded);
+  ITK_TEST_EXPECT_EQUAL(batchReader->GetRecord(numberOfFiles).FileName, missingFileName);
+
+  // Successful records hold the same samples as SWCMeshIO reads
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  for (unsigned int ii = 0; ii < numberOfFiles; ++ii)
+  {
+    if (ii == invalidFile)
+    {
+      continue;
+    }
+    const auto & record = batchReader->GetRecord(ii);
+    ITK_TEST_EXPECT_TRUE(record.Succeeded);
+    ITK_TEST_EXPECT_EQUAL(record.FileName, fileNames[ii]);
+    ITK_TEST_EXPECT_EQUAL(record.Samples.Size(), 10 * ii + 1);
+
+    swcMeshIO->SetFileName(fileNames[ii]);
+    ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+    ITK_TEST_EXPECT_TRUE(record.HeaderContent == swcMeshIO->GetHeaderContent());
+    ITK_TEST_EXPECT_TRUE(record.Samples.SampleIdentifiers ==
+                         swcMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer());
+    ITK_TEST_EXPECT_TRUE(record.Samples.Radii == swcMeshIO->GetRadii()->CastToSTLConstContainer());
+    ITK_TEST_EXPECT_TRUE(record.Samples.ParentIdentifiers ==
+                         swcMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer());
+    std::vector<float> points(3 * record.Samples.Size());
+    swcMeshIO->ReadPoints(points.data());
+    ITK_TEST_EXPECT_TRUE(record.Samples.Points == points);
+  }
+
+  // A single work unit gives the same result
+  auto serialReader = itk::SWCBatchReader::New();
+  serialReader->SetNumberOfWorkUnits(1);
+  serialReader->SetFileNames(batchReader->GetFileNames());
+  serialReader->Update();
+  ITK_TEST_EXPECT_EQUAL(serialReader->GetNumberOfFailures(), 2);
+  for (unsigned int ii = 0; ii <= numberOfFiles; ++ii)
+  {
+    ITK_TEST_EXPECT_EQUAL(serialReader->GetRecord(ii).ErrorMessage, batchReader->GetRecord(ii).ErrorMessage);
+    ITK_TEST_EXPECT_TRUE(serialReader->GetRecord(ii).Samples.Points == batchReader->GetRecord(ii).Samples.Points);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCBinaryMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+std::string
+ReadFileContent(const std::string & fileName)
+{
+  std::ifstream      inputFile(fileName.c_str(), std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << inputFile.rdbuf();
+  return content.str();
+}
+} // namespace
+
+int
+itkSWCBinaryMeshIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  const std::string swcFileName = outputDirectory + "/itkSWCBinaryMeshIOTest.swc";
+  {
+    std::ofstream outputFile(swcFileName.c_str(), std::ios::out);
+    outputFile << "# ORIGINAL_SOURCE test\n"
+               << "# SCALE 1.0 1.0 1.0\n"
+               << "1 1 0.5 -1.25 20 3.5 -1\n"
+               << "2 3 1.5 0 20 0.75 1\n"
+               << "3 3 2.5 1 20 0.5 2\n"
+               << "9000000000 2 3 2 21 0.25 1\n"
+               << "5 4 3.125 2 21 0.25 9000000000\n"
+               << "6 4 4.000001234 2 21 0.25 12345\n";
+  }
+
+  auto binaryMeshIO = itk::SWCBinaryMeshIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(binaryMeshIO, SWCBinaryMeshIO, SWCMeshIO);
+  ITK_TEST_EXPECT_TRUE(!binaryMeshIO->CanReadFile(swcFileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(!binaryMeshIO->CanWriteFile(swcFileName.c_str()));
+
+  const std::string swcbFileName = outputDirectory + "/itkSWCBinaryMeshIOTest.swcb";
+  ITK_TEST_EXPECT_TRUE(binaryMeshIO->CanWriteFile(swcbFileName.c_str()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::SWCBinaryMeshIO::ConvertSWCToSWCB(swcFileName, swcbFileName));
+  ITK_TEST_EXPECT_TRUE(binaryMeshIO->CanReadFile(swcbFileName.c_str()));
+
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  swcMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::DOUBLE);
+  swcMeshIO->SetFileName(swcFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  binaryMeshIO->SetFileName(swcbFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(binaryMeshIO->ReadMeshInformation());
+
+  // The binary file holds exactly the parsed samples
+  ITK_TEST_EXPECT_EQUAL(binaryMeshIO->GetNumberOfPoints(), 6);
+  ITK_TEST_EXPECT_EQUAL(binaryMeshIO->GetNumberOfCells(), swcMeshIO->GetNumberOfCells());
+  ITK_TEST_EXPECT_EQUAL(binaryMeshIO->GetCellBufferSize(), swcMeshIO->GetCellBufferSize());
+  ITK_TEST_EXPECT_TRUE(binaryMeshIO->GetHeaderContent() == swcMeshIO->GetHeaderContent());
+  ITK_TEST_EXPECT_TRUE(binaryMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(binaryMeshIO->GetTypeIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetTypeIdentifiers()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(binaryMeshIO->GetRadii()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetRadii()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(binaryMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer());
+
+  // The coordinates parsed in double precision are stored without rounding
+  ITK_TEST_EXPECT_EQUAL(binaryMeshIO->GetPointComponentType(), itk::IOComponentEnum::DOUBLE);
+  std::vector<double> binaryPoints(18);
+  std::vector<double> points(18);
+  binaryMeshIO->ReadPoints(binaryPoints.data());
+  swcMeshIO->ReadPoints(points.data());
+  ITK_TEST_EXPECT_TRUE(binaryPoints == points);
+  ITK_TEST_EXPECT_EQUAL(binaryPoints[15], 4.000001234);
+
+  // A requested point component type converts the stored coordinates
+  auto floatMeshIO = itk::SWCBinaryMeshIO::New();
+  floatMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::FLOAT);
+  floatMeshIO->SetFileName(swcbFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(floatMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(floatMeshIO->GetPointComponentType(), itk::IOComponentEnum::FLOAT);
+  std::vector<float> floatPoints(18);
+  floatMeshIO->ReadPoints(floatPoints.data());
+  ITK_TEST_EXPECT_EQUAL(floatPoints[15], 4.000001234f);
+
+  std::vector<unsigned int> binaryCells(binaryMeshIO->GetCellBufferSize());
+  std::vector<unsigned int> cells(swcMeshIO->GetCellBufferSize());
+  binaryMeshIO->ReadCells(binaryCells.data());
+  swcMeshIO->ReadCells(cells.data());
+  ITK_TEST_EXPECT_TRUE(binaryCells == cells);
+
+  // Reordered reads rebuild the cells for the new point indices
+  auto orderedMeshIO = itk::SWCBinaryMeshIO::New();
+  orderedMeshIO->SetSampleOrder(itk::SWCMeshIOEnums::SWCSampleOrder::BreadthFirst);
+  orderedMeshIO->SetFileName(swcbFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(orderedMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(orderedMeshIO->GetPointPermutation().size(), 6);
+  ITK_TEST_EXPECT_EQUAL(orderedMeshIO->GetPointPermutation()[1], 5);
+  std::vector<unsigned int> orderedCells(orderedMeshIO->GetCellBufferSize());
+  orderedMeshIO->ReadCells(orderedCells.data());
+  ITK_TEST_EXPECT_EQUAL(orderedCells[2], 0);
+  ITK_TEST_EXPECT_EQUAL(orderedCells[3], 2);
+  ITK_TEST_EXPECT_EQUAL(orderedCells[14], 3);
+  ITK_TEST_EXPECT_EQUAL(orderedCells[15], 5);
+
+  // Converting back reproduces the text written by SWCMeshIO
+  const std::string roundTripFileName = outputDirectory + "/itkSWCBinaryMeshIOTestRoundTrip.swc";
+  const std::string referenceFileName = outputDirectory + "/itkSWCBinaryMeshIOTestReference.swc";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::SWCBinaryMeshIO::ConvertSWCBToSWC(swcbFileName, roundTripFileName));
+  auto referenceMeshIO = itk::SWCMeshIO::New();
+  referenceMeshIO->SetFileName(referenceFileName);
+  referenceMeshIO->SetNumberOfPoints(swcMeshIO->GetNumberOfPoints());
+  referenceMeshIO->SetPointDimension(3);
+  referenceMeshIO->SetPointComponentType(itk::IOComponentEnum::DOUBLE);
+  referenceMeshIO->SetHeaderContent(swcMeshIO->GetHeaderContent());
+  referenceMeshIO->SetNativeSampleIdentifiers(swcMeshIO->GetNativeSampleIdentifiers());
+  referenceMeshIO->SetTypeIdentifiers(swcMeshIO->GetTypeIdentifiers());
+  referenceMeshIO->SetRadii(swcMeshIO->GetRadii());
+  referenceMeshIO->SetNativeParentIdentifiers(swcMeshIO->GetNativeParentIdentifiers());
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceMeshIO->WriteMeshInformation());
+  referenceMeshIO->WritePoints(static_cast<void *>(points.data()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceMeshIO->Write());
+  ITK_TEST_EXPECT_TRUE(ReadFileContent(roundTripFileName) == ReadFileContent(referenceFileName));
+  ITK_TEST_EXPECT_TRUE(ReadFileContent(roundTripFileName).find(" 4.000001234 ") != std::string::npos);
+
+  // Missing attributes are written with the SWCMeshIO defaults
+  const std::string defaultsFileName = outputDirectory + "/itkSWCBinaryMeshIOTestDefaults.swcb";
+  auto defaultsMeshIO = itk::SWCBinaryMeshIO::New();
+  defaultsMeshIO->SetFileName(defaultsFileName);
+  defaultsMeshIO->SetNumberOfPoints(2);
+  defaultsMeshIO->SetPointDimension(3);
+  defaultsMeshIO->SetPointComponentType(itk::IOComponentEnum::FLOAT);
+  ITK_TRY_EXPECT_NO_EXCEPTION(defaultsMeshIO->WriteMeshInformation());
+  defaultsMeshIO->WritePoints(static_cast<void *>(points.data()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(defaultsMeshIO->Write());
+  auto defaultsReader = itk::SWCBinaryMeshIO::New();
+  defaultsReader->SetFileName(defaultsFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(defaultsReader->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(defaultsReader->GetNumberOfPoints(), 2);
+  ITK_TEST_EXPECT_EQUAL(defaultsReader->GetPointComponentType(), itk::IOComponentEnum::FLOAT);
+  ITK_TEST_EXPECT_EQUAL(defaultsReader->GetNumberOfCells(), 0);
+  ITK_TEST_EXPECT_EQUAL(defaultsReader->GetNativeSampleIdentifiers()->GetElement(1), 2);
+  ITK_TEST_EXPECT_EQUAL(defaultsReader->GetTypeIdentifiers()->GetElement(1), 5);
+  ITK_TEST_EXPECT_EQUAL(defaultsReader->GetRadii()->GetElement(1), 1.0);
+  ITK_TEST_EXPECT_EQUAL(defaultsReader->GetNativeParentIdentifiers()->GetElement(1), -1);
+
+  // The region of interest selects the same samples as from the text file
+  auto regionMeshIO = itk::SWCBinaryMeshIO::New();
+  auto regionTextMeshIO = itk::SWCMeshIO::New();
+  for (itk::SWCMeshIO * meshIO : { static_cast<itk::SWCMeshIO *>(regionMeshIO), regionTextMeshIO.GetPointer() })
+  {
+    meshIO->UseRegionOfInterestOn();
+    meshIO->SetRegionOfInterestMinimum({ { 0.0, -2.0, 19.0 } });
+    meshIO->SetRegionOfInterestMaximum({ { 2.6, 1.5, 20.5 } });
+    meshIO->SetRegionOfInterestBoundary(itk::SWCMeshIOEnums::SWCRegionBoundary::KeepBoundarySamples);
+  }
+  regionMeshIO->SetFileName(swcbFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionMeshIO->ReadMeshInformation());
+  regionTextMeshIO->SetFileName(swcFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionTextMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNumberOfPoints(), 4);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNumberOfCells(), 3);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNativeSampleIdentifiers()->GetElement(3), 9000000000);
+  ITK_TEST_EXPECT_TRUE(regionMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       regionTextMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(regionMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       regionTextMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer());
+
+  // The subtree of a sample is renumbered as from the text file
+  auto subtreeMeshIO = itk::SWCBinaryMeshIO::New();
+  subtreeMeshIO->SetSubtreeRootIdentifier(9000000000);
+  subtreeMeshIO->SetFileName(swcbFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(subtreeMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNumberOfPoints(), 2);
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNumberOfCells(), 1);
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNativeParentIdentifiers()->GetElement(0), -1);
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNativeParentIdentifiers()->GetElement(1), 1);
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetTypeIdentifiers()->GetElement(1), 4);
+
+  // Truncated files are rejected
+  const std::string truncatedFileName = outputDirectory + "/itkSWCBinaryMeshIOTestTruncated.swcb";
+  {
+    const std::string content = ReadFileContent(swcbFileName);
+    std::ofstream     outputFile(truncatedFileName.c_str(), std::ios::out | std::ios::binary);
+    outputFile.write(content.data(), static_cast<std::streamsize>(content.size() / 2));
+  }
+  binaryMeshIO->SetFileName(truncatedFileName);
+  ITK_TRY_EXPECT_EXCEPTION(binaryMeshIO->ReadMeshInformation());
+
+  // Header counts larger than the file, or overflowing the section sizes,
+  // are rejected before allocating the sections
+  const std::string corruptFileName = outputDirectory + "/itkSWCBinaryMeshIOTestCorrupt.swcb";
+  for (const uint64_t numberOfSamples : { uint64_t{ 1 } << 40, ~uint64_t{ 0 } / 3 + 1 })
+  {
+    std::string content = ReadFileContent(swcbFileName);
+    for (unsigned int ii = 0; ii < 8; ++ii)
+    {
+      content[16 + ii] = static_cast<char>((numberOfSamples >> (8 * ii)) & 0xff);
+    }
+    {
+      std::ofstream outputFile(corruptFileName.c_str(), std::ios::out | std::ios::binary);
+      outputFile.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+    binaryMeshIO->SetFileName(corruptFileName);
+    ITK_TRY_EXPECT_EXCEPTION(binaryMeshIO->ReadMeshInformation());
+  }
+
+  // Stored cells that disagree with the parents are rejected, even when
+  // they only reference existing samples. The cell section ends the file,
+  // padded to 8 bytes.
+  for (const unsigned int cellComponent : { 2u, 3u })
+  {
+    std::string    content = ReadFileContent(swcbFileName);
+    const uint64_t cellSectionSize = 4 * static_cast<uint64_t>(static_cast<unsigned char>(content[32]));
+    const size_t   lastCell = content.size() - (8 - cellSectionSize % 8) % 8 - 16;
+    content[lastCell + 4 * cellComponent] = static_cast<char>(content[lastCell + 4 * cellComponent] == 0 ? 1 : 0);
+    {
+      std::ofstream outputFile(corruptFileName.c_str(), std::ios::out | std::ios::binary);
+      outputFile.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+    binaryMeshIO->SetFileName(corruptFileName);
+    ITK_TRY_EXPECT_EXCEPTION(binaryMeshIO->ReadMeshInformation());
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
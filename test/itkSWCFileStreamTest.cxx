@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCFileStream.h"
+#include "itkSWCMeshIO.h"
+#include "itkSWCStreamingReader.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+
+int
+itkSWCFileStreamTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  constexpr unsigned int numberOfSamples = 2000;
+  const std::string      fileName = outputDirectory + "/itkSWCFileStreamTest.swc";
+  {
+    std::ofstream outputFile(fileName.c_str(), std::ios::out);
+    outputFile << "# compressed\n";
+    for (unsigned int ii = 1; ii <= numberOfSamples; ++ii)
+    {
+      outputFile << ii << ' ' << ii % 4 << ' ' << ii << " 0.5 -1 " << 0.25 * ii << ' ' << static_cast<int>(ii) - 1
+                 << '\n';
+    }
+  }
+
+  // Plain files are read as they are
+  itk::SWCInputFileStream inputFile;
+  ITK_TEST_EXPECT_TRUE(!inputFile.Open(outputDirectory + "/itkSWCFileStreamTestMissing.swc"));
+  ITK_TEST_EXPECT_TRUE(inputFile.Open(fileName));
+  ITK_TEST_EXPECT_TRUE(!inputFile.IsCompressed());
+  char firstBytes[12];
+  ITK_TEST_EXPECT_EQUAL(inputFile.Read(firstBytes, sizeof(firstBytes)), sizeof(firstBytes));
+  ITK_TEST_EXPECT_EQUAL(std::string(firstBytes, sizeof(firstBytes)), std::string("# compressed"));
+  inputFile.Close();
+
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  swcMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  std::vector<float> points(3 * numberOfSamples);
+  swcMeshIO->ReadPoints(points.data());
+
+  // Write and read back a compressed copy
+  const std::string compressedFileName = outputDirectory + "/itkSWCFileStreamTest.swc.gz";
+  auto              writerMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_EXPECT_TRUE(writerMeshIO->CanWriteFile(compressedFileName.c_str()));
+  ITK_TEST_EXPECT_EQUAL(writerMeshIO->GetCompressionLevel(), 6);
+  writerMeshIO->SetCompressionLevel(12);
+  ITK_TEST_EXPECT_EQUAL(writerMeshIO->GetCompressionLevel(), 9);
+  writerMeshIO->SetFileName(compressedFileName);
+  writerMeshIO->SetNumberOfPoints(numberOfSamples);
+  writerMeshIO->SetPointComponentType(itk::IOComponentEnum::FLOAT);
+  writerMeshIO->SetHeaderContent(swcMeshIO->GetHeaderContent());
+  writerMeshIO->SetNativeSampleIdentifiers(swcMeshIO->GetNativeSampleIdentifiers());
+  writerMeshIO->SetTypeIdentifiers(swcMeshIO->GetTypeIdentifiers());
+  writerMeshIO->SetRadii(swcMeshIO->GetRadii());
+  writerMeshIO->SetNativeParentIdentifiers(swcMeshIO->GetNativeParentIdentifiers());
+  writerMeshIO->WritePoints(static_cast<void *>(points.data()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(writerMeshIO->Write());
+
+  ITK_TEST_EXPECT_TRUE(inputFile.Open(compressedFileName));
+  ITK_TEST_EXPECT_TRUE(inputFile.IsCompressed());
+  inputFile.Close();
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileLength(compressedFileName) <
+                       itksys::SystemTools::FileLength(fileName));
+
+  auto compressedMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_EXPECT_TRUE(compressedMeshIO->CanReadFile(compressedFileName.c_str()));
+  compressedMeshIO->SetFileName(compressedFileName);
+  compressedMeshIO->SetNumberOfWorkUnits(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(compressedMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(compressedMeshIO->GetNumberOfPoints(), numberOfSamples);
+  ITK_TEST_EXPECT_EQUAL(compressedMeshIO->GetNumberOfCells(), numberOfSamples - 1);
+  ITK_TEST_EXPECT_TRUE(compressedMeshIO->GetHeaderContent() == swcMeshIO->GetHeaderContent());
+  ITK_TEST_EXPECT_TRUE(compressedMeshIO->GetRadii()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetRadii()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(compressedMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer());
+  std::vector<float> compressedPoints(3 * numberOfSamples);
+  compressedMeshIO->ReadPoints(compressedPoints.data());
+  ITK_TEST_EXPECT_TRUE(compressedPoints == points);
+
+  // The streaming reader decompresses too
+  auto               streamingReader = itk::SWCStreamingReader::New();
+  itk::SizeValueType numberOfStreamedSamples = 0;
+  streamingReader->SetFileName(compressedFileName);
+  streamingReader->SetSampleBatchCallback(
+    [&numberOfStreamedSamples](const itk::SWCParser::SampleBuffers & samples, itk::SizeValueType) {
+      numberOfStreamedSamples += samples.Size();
+    });
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+  ITK_TEST_EXPECT_EQUAL(numberOfStreamedSamples, numberOfSamples);
+
+  // Corrupt compressed data is reported
+  const std::string corruptFileName = outputDirectory + "/itkSWCFileStreamTestCorrupt.swc.gz";
+  {
+    std::ifstream compressedFile(compressedFileName.c_str(), std::ios::in | std::ios::binary);
+    std::string   content((std::istreambuf_iterator<char>(compressedFile)), std::istreambuf_iterator<char>());
+    for (size_t ii = 20; ii < content.size() - 8; ii += 7)
+    {
+      content[ii] = static_cast<char>(~content[ii]);
+    }
+    std::ofstream outputFile(corruptFileName.c_str(), std::ios::out | std::ios::binary);
+    outputFile.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+  auto corruptMeshIO = itk::SWCMeshIO::New();
+  corruptMeshIO->SetFileName(corruptFileName);
+  ITK_TRY_EXPECT_EXCEPTION(corruptMeshIO->ReadMeshInformation());
+
+  // Truncated compressed data is reported, whether the file ends inside the
+  // deflate data or inside the trailer
+  const std::string truncatedFileName = outputDirectory + "/itkSWCFileStreamTestTruncated.swc.gz";
+  std::string       compressedContent;
+  {
+    std::ifstream compressedFile(compressedFileName.c_str(), std::ios::in | std::ios::binary);
+    compressedContent.assign(std::istreambuf_iterator<char>(compressedFile), std::istreambuf_iterator<char>());
+  }
+  for (const size_t truncatedSize : { compressedContent.size() / 2, compressedContent.size() - 4 })
+  {
+    {
+      std::ofstream outputFile(truncatedFileName.c_str(), std::ios::out | std::ios::binary);
+      outputFile.write(compressedContent.data(), static_cast<std::streamsize>(truncatedSize));
+    }
+    ITK_TEST_EXPECT_TRUE(inputFile.Open(truncatedFileName));
+    std::vector<char> content(64 * numberOfSamples);
+    while (inputFile.Read(content.data(), content.size()) > 0)
+    {
+    }
+    inputFile.Close();
+    ITK_TEST_EXPECT_TRUE(inputFile.HasError());
+
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+    {
+      auto truncatedMeshIO = itk::SWCMeshIO::New();
+      truncatedMeshIO->SetNumberOfWorkUnits(numberOfWorkUnits);
+      truncatedMeshIO->SetFileName(truncatedFileName);
+      ITK_TRY_EXPECT_EXCEPTION(truncatedMeshIO->ReadMeshInformation());
+    }
+    streamingReader->SetFileName(truncatedFileName);
+    ITK_TRY_EXPECT_EXCEPTION(streamingReader->Update());
+  }
+  ITK_TEST_EXPECT_TRUE(inputFile.Open(compressedFileName));
+  ITK_TEST_EXPECT_TRUE(!inputFile.HasError());
+  inputFile.Close();
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,549 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMath.h"
+#include "itkMesh.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumberToString.h"
+#include "itkSWCMeshIO.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+namespace
+{
+// Write a synthetic chain of numberOfSamples samples.
+void
+WriteSyntheticSWC(const std::string & fileName, itk::SizeValueType numberOfSamples)
+{
+  std::ofstream outputFile(fileName.c_str(), std::ios::out);
+  outputFile << "# synthetic reconstruction\n";
+  for (itk::SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+  {
+    outputFile << ii + 1 << ' ' << (ii % 4) + 1 << ' ' << 0.125 * ii << ' ' << 0.5 * (ii % 1000) << ' '
+               << 0.25 * (ii % 333) << ' ' << 0.5 + 0.001 * (ii % 500) << ' '
+               << (ii == 0 ? -1 : static_cast<long long>(ii)) << '\n';
+  }
+}
+
+// Write a densely sampled reconstruction of numberOfSamples samples of one
+// type along helices of radius 10, with a branch every 1000 samples.
+void
+WriteDenseSWC(const std::string & fileName, itk::SizeValueType numberOfSamples)
+{
+  std::ofstream outputFile(fileName.c_str(), std::ios::out);
+  outputFile << "# dense reconstruction\n";
+  for (itk::SizeValueType ii = 0; ii < numberOfSamples; ++ii)
+  {
+    const long long parent = ii == 0 ? -1 : static_cast<long long>(ii % 1000 == 0 ? ii - 499 : ii);
+    outputFile << ii + 1 << " 3 " << 10.0 * std::cos(0.01 * ii) << ' ' << 10.0 * std::sin(0.01 * ii) << ' '
+               << 0.05 * ii << " 1 " << parent << '\n';
+  }
+}
+
+// The std::getline / std::istringstream parse previously used by SWCMeshIO.
+itk::SizeValueType
+ReadWithStringStreams(const std::string & fileName, std::vector<float> & points)
+{
+  std::ifstream inputFile(fileName.c_str(), std::ios::in);
+  std::string   line;
+  std::getline(inputFile, line);
+  std::getline(inputFile, line);
+  itk::SizeValueType numberOfSamples = 0;
+  while (!inputFile.eof())
+  {
+    std::istringstream istrm(line);
+    float              sampleIdentifier;
+    float              typeIdentifier;
+    double             pointComponent[3];
+    double             radius;
+    float              parentIdentifier;
+    istrm >> sampleIdentifier >> typeIdentifier >> pointComponent[0] >> pointComponent[1] >> pointComponent[2] >>
+      radius >> parentIdentifier;
+    points.insert(points.end(), pointComponent, pointComponent + 3);
+    std::getline(inputFile, line);
+    ++numberOfSamples;
+  }
+  return numberOfSamples;
+}
+
+// The std::ostream based writer previously used by SWCMeshIO.
+void
+WriteWithStreams(const std::string & fileName, const itk::SWCMeshIO * swcMeshIO, const std::vector<float> & points)
+{
+  std::ofstream outputFile(fileName.c_str(), std::ios::out);
+  for (const auto & headerLine : swcMeshIO->GetHeaderContent())
+  {
+    outputFile << "#" << headerLine << "\n";
+  }
+  const std::string sep(" ");
+  for (itk::SizeValueType ii = 0; ii < swcMeshIO->GetNumberOfPoints(); ++ii)
+  {
+    outputFile << swcMeshIO->GetNativeSampleIdentifiers()->GetElement(ii) << sep;
+    outputFile << swcMeshIO->GetTypeIdentifiers()->GetElement(ii) << sep;
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      outputFile << itk::ConvertNumberToString(points[3 * ii + jj]) << sep;
+    }
+    outputFile << swcMeshIO->GetRadii()->GetElement(ii) << sep;
+    outputFile << swcMeshIO->GetNativeParentIdentifiers()->GetElement(ii) << "\n";
+  }
+}
+
+// Distance from point to the segment of pointIndex to parentIndex, with
+// the radius interpolated along the segment.
+double
+ComputeSegmentDistance(const double *     point,
+                       const float *      points,
+                       const double *     radii,
+                       itk::SizeValueType pointIndex,
+                       itk::SizeValueType parentIndex)
+{
+  double offset[3];
+  double direction[3];
+  double projection = 0.0;
+  double squaredLength = 0.0;
+  for (unsigned int jj = 0; jj < 3; ++jj)
+  {
+    offset[jj] = point[jj] - points[3 * pointIndex + jj];
+    direction[jj] = static_cast<double>(points[3 * parentIndex + jj]) - points[3 * pointIndex + jj];
+    projection += offset[jj] * direction[jj];
+    squaredLength += direction[jj] * direction[jj];
+  }
+  const double parameter = squaredLength > 0.0 ? std::min(1.0, std::max(0.0, projection / squaredLength)) : 0.0;
+  double       squaredDistance = 0.0;
+  for (unsigned int jj = 0; jj < 3; ++jj)
+  {
+    const double difference = offset[jj] - parameter * direction[jj];
+    squaredDistance += difference * difference;
+  }
+  const double radius = radii[pointIndex] + parameter * (radii[parentIndex] - radii[pointIndex]);
+  return std::max(0.0, std::sqrt(squaredDistance) - radius);
+}
+
+// Time nearest segment queries around the samples of swcMeshIO with a
+// brute force search over the line cells, then with SWCSegmentLocator.
+bool
+BenchmarkSegmentLocator(itk::SWCMeshIO * swcMeshIO, unsigned int numberOfQueries, itk::ThreadIdType numberOfWorkUnits)
+{
+  const itk::SizeValueType  numberOfPoints = swcMeshIO->GetNumberOfPoints();
+  std::vector<float>        points(3 * numberOfPoints);
+  std::vector<unsigned int> cells(swcMeshIO->GetCellBufferSize());
+  swcMeshIO->ReadPoints(points.data());
+  swcMeshIO->ReadCells(cells.data());
+  const double * radii = swcMeshIO->GetRadii()->CastToSTLConstContainer().data();
+
+  std::mt19937                           generator(1);
+  std::uniform_int_distribution<size_t> sampleDistribution(0, numberOfPoints - 1);
+  std::uniform_real_distribution<double> offsetDistribution(-10.0, 10.0);
+  std::vector<double>                    queryPoints(3 * numberOfQueries);
+  for (unsigned int ii = 0; ii < 3 * numberOfQueries; ++ii)
+  {
+    queryPoints[ii] = points[3 * sampleDistribution(generator) + ii % 3] + offsetDistribution(generator);
+  }
+
+  // Roots are the points that are not the second point of a line cell
+  itk::TimeProbe      bruteForceProbe;
+  std::vector<double> bruteForceDistances(numberOfQueries);
+  bruteForceProbe.Start();
+  std::vector<bool> isRoot(numberOfPoints, true);
+  for (itk::SizeValueType ii = 0; ii < cells.size(); ii += 4)
+  {
+    isRoot[cells[ii + 3]] = false;
+  }
+  for (unsigned int ii = 0; ii < numberOfQueries; ++ii)
+  {
+    const double * queryPoint = queryPoints.data() + 3 * ii;
+    double         nearestDistance = std::numeric_limits<double>::infinity();
+    for (itk::SizeValueType jj = 0; jj < cells.size(); jj += 4)
+    {
+      const double distance = ComputeSegmentDistance(queryPoint, points.data(), radii, cells[jj + 3], cells[jj + 2]);
+      nearestDistance = std::min(nearestDistance, distance);
+    }
+    for (itk::SizeValueType jj = 0; jj < numberOfPoints; ++jj)
+    {
+      if (isRoot[jj])
+      {
+        nearestDistance = std::min(nearestDistance, ComputeSegmentDistance(queryPoint, points.data(), radii, jj, jj));
+      }
+    }
+    bruteForceDistances[ii] = nearestDistance;
+  }
+  bruteForceProbe.Stop();
+
+  itk::SWCSegmentLocator locator;
+  itk::TimeProbe         buildProbe;
+  buildProbe.Start();
+  swcMeshIO->BuildSegmentLocator(locator);
+  buildProbe.Stop();
+
+  itk::SWCSegmentLocator parallelLocator;
+  parallelLocator.SetNumberOfWorkUnits(numberOfWorkUnits);
+  itk::TimeProbe parallelBuildProbe;
+  parallelBuildProbe.Start();
+  swcMeshIO->BuildSegmentLocator(parallelLocator);
+  parallelBuildProbe.Stop();
+
+  std::vector<itk::SWCSegmentLocator::QueryResultType> results(numberOfQueries);
+  itk::TimeProbe                                       queryProbe;
+  queryProbe.Start();
+  locator.FindNearestSegments(queryPoints.data(), numberOfQueries, results.data());
+  queryProbe.Stop();
+
+  std::vector<itk::SWCSegmentLocator::QueryResultType> parallelResults(numberOfQueries);
+  itk::TimeProbe                                       parallelQueryProbe;
+  parallelQueryProbe.Start();
+  parallelLocator.FindNearestSegments(queryPoints.data(), numberOfQueries, parallelResults.data());
+  parallelQueryProbe.Stop();
+
+  bool passed = true;
+  for (unsigned int ii = 0; ii < numberOfQueries; ++ii)
+  {
+    if (std::abs(results[ii].Distance - bruteForceDistances[ii]) > 1e-9 * std::max(1.0, bruteForceDistances[ii]) ||
+        parallelResults[ii].PointIndex != results[ii].PointIndex)
+    {
+      std::cerr << "Nearest segment of query " << ii << " at " << results[ii].Distance << ". Expected "
+                << bruteForceDistances[ii] << std::endl;
+      passed = false;
+    }
+  }
+
+  std::cout << "Nearest segment of " << numberOfQueries << " points among " << numberOfPoints << " segments"
+            << std::endl;
+  std::cout << "  brute force:             " << bruteForceProbe.GetTotal() << " s, "
+            << numberOfQueries / bruteForceProbe.GetTotal() << " queries/s" << std::endl;
+  std::cout << "  SWCSegmentLocator build: " << buildProbe.GetTotal() << " s, " << locator.GetNumberOfNodes()
+            << " nodes" << std::endl;
+  std::cout << "  SWCSegmentLocator build, " << numberOfWorkUnits << " work units: " << parallelBuildProbe.GetTotal()
+            << " s" << std::endl;
+  std::cout << "  SWCSegmentLocator:       " << queryProbe.GetTotal() << " s, "
+            << numberOfQueries / queryProbe.GetTotal() << " queries/s" << std::endl;
+  std::cout << "  SWCSegmentLocator, " << numberOfWorkUnits << " work units: " << parallelQueryProbe.GetTotal()
+            << " s, " << numberOfQueries / parallelQueryProbe.GetTotal() << " queries/s" << std::endl;
+  return passed;
+}
+
+// Report the cells of fileName and their memory in an itk::Mesh, with one
+// line cell per sample, then with one polyline cell per unbranched section.
+bool
+ReportPolyLineCells(const std::string & fileName)
+{
+  using MeshType = itk::Mesh<double, 3>;
+  using LineCellType = itk::LineCell<MeshType::CellType>;
+  using PolyLineCellType = itk::PolyLineCell<MeshType::CellType>;
+
+  std::cout << "Cells of " << fileName << std::endl;
+  double totalLengths[2];
+  for (const bool usePolyLineCells : { false, true })
+  {
+    auto meshIO = itk::SWCMeshIO::New();
+    meshIO->SetUsePolyLineCells(usePolyLineCells);
+    meshIO->SetCellDataContent(itk::SWCMeshIOEnums::SWCCellData::Length);
+    meshIO->SetFileName(fileName);
+    meshIO->ReadMeshInformation();
+    const itk::SizeValueType cellBufferSize = meshIO->GetCellBufferSize();
+    auto                     mesh = MeshType::New();
+    meshIO->TransferToMesh(mesh.GetPointer());
+
+    // The cell objects, the point identifiers of the polylines, the cell
+    // pointers and the cell data
+    const auto &       cells = mesh->GetCells()->CastToSTLConstContainer();
+    itk::SizeValueType cellMemory = cells.size() * (sizeof(MeshType::CellType *) + sizeof(double));
+    for (const auto * cell : cells)
+    {
+      cellMemory += usePolyLineCells
+                      ? sizeof(PolyLineCellType) + cell->GetNumberOfPoints() * sizeof(MeshType::PointIdentifier)
+                      : sizeof(LineCellType);
+    }
+    const auto & lengths = mesh->GetCellData()->CastToSTLConstContainer();
+    totalLengths[usePolyLineCells] = std::accumulate(lengths.begin(), lengths.end(), 0.0);
+
+    std::cout << (usePolyLineCells ? "  polyline cells:          " : "  line cells:              ") << cells.size()
+              << " cells, " << cellBufferSize << " cell buffer values, " << cellMemory << " bytes in the mesh"
+              << std::endl;
+  }
+  return std::abs(totalLengths[1] - totalLengths[0]) <= 1e-9 * totalLengths[0];
+}
+
+// Time reading fileName into an itk::Mesh, then with decimation to
+// tolerance, and report the samples kept.
+bool
+BenchmarkDecimation(const std::string & fileName, double tolerance)
+{
+  using MeshType = itk::Mesh<double, 3>;
+
+  itk::SizeValueType numberOfPoints[2];
+  itk::TimeProbe     probes[2];
+  for (const bool decimate : { false, true })
+  {
+    auto meshIO = itk::SWCMeshIO::New();
+    meshIO->SetDecimationTolerance(decimate ? tolerance : 0.0);
+    meshIO->SetFileName(fileName);
+    auto mesh = MeshType::New();
+    probes[decimate].Start();
+    meshIO->ReadMeshInformation();
+    meshIO->TransferToMesh(mesh.GetPointer());
+    probes[decimate].Stop();
+    numberOfPoints[decimate] = mesh->GetNumberOfPoints();
+  }
+
+  std::cout << "Decimation of " << fileName << " to " << tolerance << std::endl;
+  std::cout << "  full read:               " << probes[0].GetTotal() << " s, " << numberOfPoints[0] << " samples"
+            << std::endl;
+  std::cout << "  decimated read:          " << probes[1].GetTotal() << " s, " << numberOfPoints[1] << " samples"
+            << std::endl;
+  return numberOfPoints[1] <= numberOfPoints[0];
+}
+
+} // namespace
+
+int
+itkSWCMeshIOBenchmark(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory numberOfSamples [inputFile ...]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string        outputDirectory = argv[1];
+  const itk::SizeValueType numberOfSamples = std::stoul(argv[2]);
+
+  const std::string fileName = outputDirectory + "/itkSWCMeshIOBenchmark.swc";
+  WriteSyntheticSWC(fileName, numberOfSamples);
+
+  itk::TimeProbe     referenceProbe;
+  std::vector<float> referencePoints;
+  referenceProbe.Start();
+  const itk::SizeValueType referenceNumberOfSamples = ReadWithStringStreams(fileName, referencePoints);
+  referenceProbe.Stop();
+
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  swcMeshIO->SetFileName(fileName);
+  itk::TimeProbe readProbe;
+  readProbe.Start();
+  swcMeshIO->ReadMeshInformation();
+  readProbe.Stop();
+
+  ITK_TEST_EXPECT_EQUAL(referenceNumberOfSamples, numberOfSamples);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetNumberOfPoints(), numberOfSamples);
+  std::vector<float> points(3 * numberOfSamples);
+  swcMeshIO->ReadPoints(points.data());
+  for (itk::SizeValueType ii = 0; ii < points.size(); ++ii)
+  {
+    ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(points[ii], referencePoints[ii]));
+  }
+
+  auto parallelMeshIO = itk::SWCMeshIO::New();
+  parallelMeshIO->SetFileName(fileName);
+  parallelMeshIO->SetNumberOfWorkUnits(
+    std::max<itk::ThreadIdType>(2, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  itk::TimeProbe parallelReadProbe;
+  parallelReadProbe.Start();
+  parallelMeshIO->ReadMeshInformation();
+  parallelReadProbe.Stop();
+
+  std::vector<float> parallelPoints(3 * numberOfSamples);
+  parallelMeshIO->ReadPoints(parallelPoints.data());
+  ITK_TEST_EXPECT_TRUE(parallelPoints == points);
+  ITK_TEST_EXPECT_TRUE(parallelMeshIO->GetParentIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetParentIdentifiers()->CastToSTLConstContainer());
+
+  std::cout << "Read " << numberOfSamples << " samples" << std::endl;
+  std::cout << "  getline + istringstream: " << referenceProbe.GetTotal() << " s, "
+            << numberOfSamples / referenceProbe.GetTotal() << " samples/s" << std::endl;
+  std::cout << "  SWCMeshIO:               " << readProbe.GetTotal() << " s, "
+            << numberOfSamples / readProbe.GetTotal() << " samples/s" << std::endl;
+  std::cout << "  SWCMeshIO, " << parallelMeshIO->GetNumberOfWorkUnits() << " work units: "
+            << parallelReadProbe.GetTotal() << " s, " << numberOfSamples / parallelReadProbe.GetTotal() << " samples/s"
+            << std::endl;
+
+  // Writing
+  const std::string referenceOutputFileName = outputDirectory + "/itkSWCMeshIOBenchmarkStreams.swc";
+  itk::TimeProbe    referenceWriteProbe;
+  referenceWriteProbe.Start();
+  WriteWithStreams(referenceOutputFileName, swcMeshIO, points);
+  referenceWriteProbe.Stop();
+
+  const std::string outputFileName = outputDirectory + "/itkSWCMeshIOBenchmarkOutput.swc";
+  auto              writerMeshIO = itk::SWCMeshIO::New();
+  writerMeshIO->SetFileName(outputFileName);
+  writerMeshIO->SetNumberOfPoints(numberOfSamples);
+  writerMeshIO->SetPointComponentType(itk::IOComponentEnum::FLOAT);
+  writerMeshIO->SetHeaderContent(swcMeshIO->GetHeaderContent());
+  writerMeshIO->SetNativeSampleIdentifiers(swcMeshIO->GetNativeSampleIdentifiers());
+  writerMeshIO->SetTypeIdentifiers(swcMeshIO->GetTypeIdentifiers());
+  writerMeshIO->SetRadii(swcMeshIO->GetRadii());
+  writerMeshIO->SetNativeParentIdentifiers(swcMeshIO->GetNativeParentIdentifiers());
+  itk::TimeProbe writeProbe;
+  writeProbe.Start();
+  writerMeshIO->WriteMeshInformation();
+  writerMeshIO->WritePoints(static_cast<void *>(points.data()));
+  writerMeshIO->Write();
+  writeProbe.Stop();
+
+  const std::string parallelOutputFileName = outputDirectory + "/itkSWCMeshIOBenchmarkParallelOutput.swc";
+  writerMeshIO->SetFileName(parallelOutputFileName);
+  writerMeshIO->SetNumberOfWorkUnits(parallelMeshIO->GetNumberOfWorkUnits());
+  itk::TimeProbe parallelWriteProbe;
+  parallelWriteProbe.Start();
+  writerMeshIO->WriteMeshInformation();
+  writerMeshIO->Write();
+  parallelWriteProbe.Stop();
+
+  // The parallel writer output is byte-identical to the serial one
+  std::ifstream     serialOutput(outputFileName.c_str(), std::ios::in | std::ios::binary);
+  std::ifstream     parallelOutput(parallelOutputFileName.c_str(), std::ios::in | std::ios::binary);
+  std::stringstream serialContent;
+  std::stringstream parallelContent;
+  serialContent << serialOutput.rdbuf();
+  parallelContent << parallelOutput.rdbuf();
+  ITK_TEST_EXPECT_TRUE(serialContent.str() == parallelContent.str());
+
+  // The written file reads back to the same samples
+  auto rereadMeshIO = itk::SWCMeshIO::New();
+  rereadMeshIO->SetFileName(outputFileName);
+  rereadMeshIO->ReadMeshInformation();
+  ITK_TEST_EXPECT_EQUAL(rereadMeshIO->GetNumberOfPoints(), numberOfSamples);
+  std::vector<float> rereadPoints(3 * numberOfSamples);
+  rereadMeshIO->ReadPoints(rereadPoints.data());
+  ITK_TEST_EXPECT_TRUE(rereadPoints == points);
+  ITK_TEST_EXPECT_TRUE(rereadMeshIO->GetRadii()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetRadii()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(rereadMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer());
+
+  std::cout << "Write " << numberOfSamples << " samples" << std::endl;
+  std::cout << "  ostream:                 " << referenceWriteProbe.GetTotal() << " s, "
+            << numberOfSamples / referenceWriteProbe.GetTotal() << " samples/s" << std::endl;
+  std::cout << "  SWCMeshIO:               " << writeProbe.GetTotal() << " s, "
+            << numberOfSamples / writeProbe.GetTotal() << " samples/s" << std::endl;
+  std::cout << "  SWCMeshIO, " << writerMeshIO->GetNumberOfWorkUnits() << " work units: "
+            << parallelWriteProbe.GetTotal() << " s, " << numberOfSamples / parallelWriteProbe.GetTotal()
+            << " samples/s" << std::endl;
+
+  // Morphometrics, by walking the cells of an itk::Mesh as pipelines did
+  // before, then on the arrays of the IO
+  using MeshType = itk::Mesh<double, 3>;
+  auto meshIO = itk::SWCMeshIO::New();
+  meshIO->SetPointDataContent(itk::SWCMeshIOEnums::SWCPointData::Radius);
+  meshIO->SetFileName(fileName);
+  meshIO->ReadMeshInformation();
+  const itk::SWCMeshIO::TypeIdentifierContainerType::ConstPointer typeIdentifiers = meshIO->GetTypeIdentifiers();
+  auto                                                            mesh = MeshType::New();
+  meshIO->TransferToMesh(mesh.GetPointer());
+
+  itk::TimeProbe meshMorphometricsProbe;
+  meshMorphometricsProbe.Start();
+  double                    meshLength = 0.0;
+  double                    meshVolume = 0.0;
+  std::map<float, double>   meshTypeLengths;
+  std::vector<unsigned int> numberOfChildren(numberOfSamples);
+  for (const auto * cell : mesh->GetCells()->CastToSTLConstContainer())
+  {
+    const auto   parentIndex = cell->PointIdsBegin()[0];
+    const auto   pointIndex = cell->PointIdsBegin()[1];
+    const auto & parentPoint = mesh->GetPoints()->GetElement(parentIndex);
+    const auto & point = mesh->GetPoints()->GetElement(pointIndex);
+    double       squaredLength = 0.0;
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      const double difference = static_cast<double>(point[jj]) - static_cast<double>(parentPoint[jj]);
+      squaredLength += difference * difference;
+    }
+    const double length = std::sqrt(squaredLength);
+    const double radius0 = mesh->GetPointData()->GetElement(parentIndex);
+    const double radius1 = mesh->GetPointData()->GetElement(pointIndex);
+    meshLength += length;
+    meshVolume += itk::Math::pi / 3.0 * length * (radius0 * radius0 + radius0 * radius1 + radius1 * radius1);
+    meshTypeLengths[typeIdentifiers->GetElement(pointIndex)] += length;
+    ++numberOfChildren[parentIndex];
+  }
+  const auto meshNumberOfTips = std::count(numberOfChildren.begin(), numberOfChildren.end(), 0u);
+  meshMorphometricsProbe.Stop();
+
+  itk::SWCMorphometrics morphometrics;
+  itk::TimeProbe        morphometricsProbe;
+  morphometricsProbe.Start();
+  swcMeshIO->ComputeMorphometrics(morphometrics);
+  morphometricsProbe.Stop();
+
+  itk::SWCMorphometrics parallelMorphometrics;
+  parallelMorphometrics.SetNumberOfWorkUnits(parallelMeshIO->GetNumberOfWorkUnits());
+  itk::TimeProbe parallelMorphometricsProbe;
+  parallelMorphometricsProbe.Start();
+  swcMeshIO->ComputeMorphometrics(parallelMorphometrics);
+  parallelMorphometricsProbe.Stop();
+
+  for (const auto * result : { &morphometrics, &parallelMorphometrics })
+  {
+    ITK_TEST_EXPECT_EQUAL(result->GetNumberOfTips(), static_cast<itk::SizeValueType>(meshNumberOfTips));
+    ITK_TEST_EXPECT_TRUE(std::abs(result->GetTotalLength() - meshLength) <= 1e-9 * meshLength);
+    ITK_TEST_EXPECT_TRUE(std::abs(result->GetTotalVolume() - meshVolume) <= 1e-9 * meshVolume);
+    ITK_TEST_EXPECT_EQUAL(result->GetTypeMeasures().size(), meshTypeLengths.size());
+    ITK_TEST_EXPECT_TRUE(std::abs(result->GetTypeMeasures()[1].Length - meshTypeLengths[2.0f]) <=
+                         1e-9 * meshTypeLengths[2.0f]);
+  }
+
+  std::cout << "Morphometrics of " << numberOfSamples << " samples" << std::endl;
+  std::cout << "  itk::Mesh cell walk:     " << meshMorphometricsProbe.GetTotal() << " s, "
+            << numberOfSamples / meshMorphometricsProbe.GetTotal() << " samples/s" << std::endl;
+  std::cout << "  SWCMorphometrics:        " << morphometricsProbe.GetTotal() << " s, "
+            << numberOfSamples / morphometricsProbe.GetTotal() << " samples/s" << std::endl;
+  std::cout << "  SWCMorphometrics, " << parallelMorphometrics.GetNumberOfWorkUnits()
+            << " work units: " << parallelMorphometricsProbe.GetTotal() << " s, "
+            << numberOfSamples / parallelMorphometricsProbe.GetTotal() << " samples/s" << std::endl;
+
+  // Nearest segment queries on the synthetic reconstruction, then on the
+  // reconstructions given on the command line
+  ITK_TEST_EXPECT_TRUE(BenchmarkSegmentLocator(swcMeshIO, 200, parallelMeshIO->GetNumberOfWorkUnits()));
+  for (int ii = 3; ii < argc; ++ii)
+  {
+    auto inputMeshIO = itk::SWCMeshIO::New();
+    inputMeshIO->SetFileName(argv[ii]);
+    inputMeshIO->ReadMeshInformation();
+    std::cout << argv[ii] << std::endl;
+    ITK_TEST_EXPECT_TRUE(BenchmarkSegmentLocator(inputMeshIO, 20000, parallelMeshIO->GetNumberOfWorkUnits()));
+  }
+
+  // Cells and their memory with line, then polyline cells
+  ITK_TEST_EXPECT_TRUE(ReportPolyLineCells(fileName));
+  for (int ii = 3; ii < argc; ++ii)
+  {
+    ITK_TEST_EXPECT_TRUE(ReportPolyLineCells(argv[ii]));
+  }
+
+  // Reads with decimation to half the sample spacing of a dense
+  // reconstruction
+  const std::string denseFileName = outputDirectory + "/itkSWCMeshIOBenchmarkDense.swc";
+  WriteDenseSWC(denseFileName, numberOfSamples);
+  ITK_TEST_EXPECT_TRUE(BenchmarkDecimation(denseFileName, 0.05));
+  for (int ii = 3; ii < argc; ++ii)
+  {
+    ITK_TEST_EXPECT_TRUE(BenchmarkDecimation(argv[ii], 0.05));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
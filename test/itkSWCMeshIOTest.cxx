@@ -0,0 +1,628 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMath.h"
+#include "itkMesh.h"
+#include "itkSWCMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+int
+itkSWCMeshIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // Mixed line endings, tab separators, trailing comments and blank lines
+  const std::string fileName = outputDirectory + "/itkSWCMeshIOTest.swc";
+  {
+    std::ofstream outputFile(fileName.c_str(), std::ios::out | std::ios::binary);
+    outputFile << "# ORIGINAL_SOURCE test\r\n"
+               << "#SCALE 1.0 1.0 1.0\n"
+               << "\n"
+               << "1 1 0.5 -1.25 2e1 3.5 -1 # soma\r\n"
+               << "2\t3\t1.5\t0.0\t20\t0.75\t1\r\n"
+               << "   \t\r\n"
+               << "3 3 +2.5 1 20 0.5 2\n"
+               << "# a comment between samples\n"
+               << "4 2 3 2 21 0.25 1";
+  }
+
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_EXPECT_TRUE(swcMeshIO->CanReadFile(fileName.c_str()));
+  swcMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetNumberOfPoints(), 4);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetNumberOfCells(), 3);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetHeaderContent().size(), 3);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetHeaderContent()[0], std::string(" ORIGINAL_SOURCE test"));
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetHeaderContent()[2], std::string(" a comment between samples"));
+
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetSampleIdentifiers()->GetElement(3), 4);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetTypeIdentifiers()->GetElement(1), 3);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetRadii()->GetElement(0), 3.5);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetParentIdentifiers()->GetElement(0), -1);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetParentIdentifiers()->GetElement(3), 1);
+
+  float points[12];
+  swcMeshIO->ReadPoints(points);
+  ITK_TEST_EXPECT_EQUAL(points[1], -1.25f);
+  ITK_TEST_EXPECT_EQUAL(points[2], 20.0f);
+  ITK_TEST_EXPECT_EQUAL(points[6], 2.5f);
+
+  // All attributes are exposed as one four component point pixel
+  auto attributesMeshIO = itk::SWCMeshIO::New();
+  attributesMeshIO->SetPointDataContent(itk::SWCMeshIOEnums::SWCPointData::AllAttributes);
+  attributesMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(attributesMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(attributesMeshIO->GetPointPixelType() == itk::IOPixelEnum::VECTOR);
+  ITK_TEST_EXPECT_EQUAL(attributesMeshIO->GetNumberOfPointPixelComponents(), 4);
+  ITK_TEST_EXPECT_TRUE(attributesMeshIO->GetPointPixelComponentType() == itk::IOComponentEnum::DOUBLE);
+  double attributes[16];
+  attributesMeshIO->ReadPointData(attributes);
+  ITK_TEST_EXPECT_EQUAL(attributes[4], 2.0);
+  ITK_TEST_EXPECT_EQUAL(attributes[5], 3.0);
+  ITK_TEST_EXPECT_EQUAL(attributes[6], 0.75);
+  ITK_TEST_EXPECT_EQUAL(attributes[7], 1.0);
+  ITK_TEST_EXPECT_EQUAL(attributes[3], -1.0);
+
+  // The parallel parse produces the same samples as the serial one
+  auto parallelMeshIO = itk::SWCMeshIO::New();
+  parallelMeshIO->SetNumberOfWorkUnits(3);
+  ITK_TEST_SET_GET_VALUE(3, parallelMeshIO->GetNumberOfWorkUnits());
+  parallelMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(parallelMeshIO->GetNumberOfPoints(), swcMeshIO->GetNumberOfPoints());
+  ITK_TEST_EXPECT_TRUE(parallelMeshIO->GetHeaderContent() == swcMeshIO->GetHeaderContent());
+  ITK_TEST_EXPECT_TRUE(parallelMeshIO->GetSampleIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetSampleIdentifiers()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(parallelMeshIO->GetRadii()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetRadii()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(parallelMeshIO->GetParentIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetParentIdentifiers()->CastToSTLConstContainer());
+
+  // Identifiers above 2^24 are kept exactly and resolved through the index
+  const std::string sparseFileName = outputDirectory + "/itkSWCMeshIOTestSparse.swc";
+  {
+    std::ofstream outputFile(sparseFileName.c_str(), std::ios::out);
+    outputFile << "16777217 1 0 0 0 1 -1\n"
+               << "16777218 3 1 0 0 1 16777217\n"
+               << "9000000000 3 2 0 0 1 16777218\n"
+               << "7.0 3 3 0 0 1 9000000000\n"
+               << "8 3 4 0 0 1 12345\n";
+  }
+  swcMeshIO->SetFileName(sparseFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetNativeSampleIdentifiers()->GetElement(1), 16777218);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetNativeSampleIdentifiers()->GetElement(3), 7);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetNativeParentIdentifiers()->GetElement(3), 9000000000);
+  // The float identifiers are rounded, and converted into a new container on
+  // every call
+  const auto floatSampleIdentifiers = swcMeshIO->GetSampleIdentifiers();
+  ITK_TEST_EXPECT_EQUAL(floatSampleIdentifiers->GetElement(0), 16777216.0f);
+  ITK_TEST_EXPECT_TRUE(swcMeshIO->GetSampleIdentifiers() != floatSampleIdentifiers);
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetParentIdentifiers()->GetElement(1), 16777216.0f);
+  // The parent of the last sample is missing, so it does not produce a cell
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetNumberOfCells(), 3);
+  unsigned int cells[12];
+  swcMeshIO->ReadCells(cells);
+  ITK_TEST_EXPECT_EQUAL(cells[2], 0);
+  ITK_TEST_EXPECT_EQUAL(cells[3], 1);
+  ITK_TEST_EXPECT_EQUAL(cells[10], 2);
+  ITK_TEST_EXPECT_EQUAL(cells[11], 3);
+
+  itk::SWCIdentifierIndex                                          index;
+  const std::vector<itk::SWCIdentifierIndex::IdentifierValueType> contiguous{ 1, 2, 3, 4 };
+  index.Build(contiguous.data(), contiguous.size());
+  ITK_TEST_EXPECT_TRUE(index.GetMode() == itk::SWCIdentifierIndex::Mode::Offset);
+  ITK_TEST_EXPECT_EQUAL(index.Find(3), 2);
+  ITK_TEST_EXPECT_EQUAL(index.Find(5), itk::SWCIdentifierIndex::InvalidIndex);
+  const std::vector<itk::SWCIdentifierIndex::IdentifierValueType> dense{ 4, 2, 3, 1, 9 };
+  index.Build(dense.data(), dense.size());
+  ITK_TEST_EXPECT_TRUE(index.GetMode() == itk::SWCIdentifierIndex::Mode::Dense);
+  ITK_TEST_EXPECT_EQUAL(index.Find(9), 4);
+  ITK_TEST_EXPECT_EQUAL(index.Find(5), itk::SWCIdentifierIndex::InvalidIndex);
+  const std::vector<itk::SWCIdentifierIndex::IdentifierValueType> sparse{ 10, -1000000, 7 };
+  index.Build(sparse.data(), sparse.size());
+  ITK_TEST_EXPECT_TRUE(index.GetMode() == itk::SWCIdentifierIndex::Mode::Sparse);
+  ITK_TEST_EXPECT_EQUAL(index.Find(-1000000), 1);
+  ITK_TEST_EXPECT_EQUAL(index.Find(0), itk::SWCIdentifierIndex::InvalidIndex);
+
+  // Child adjacency of a forest whose roots are not the first samples
+  const std::string forestFileName = outputDirectory + "/itkSWCMeshIOTestForest.swc";
+  {
+    std::ofstream outputFile(forestFileName.c_str(), std::ios::out);
+    outputFile << "10 3 0 0 0 1 20\n"
+               << "20 1 0 0 0 1 -1\n"
+               << "30 3 0 0 0 1 20\n"
+               << "40 3 0 0 0 1 10\n"
+               << "50 1 0 0 0 1 -1\n"
+               << "60 3 0 0 0 1 50\n"
+               << "70 3 0 0 0 1 99\n";
+  }
+  auto topologyMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(topologyMeshIO, ComputeTopology, false);
+  topologyMeshIO->ComputeTopologyOn();
+  topologyMeshIO->SetFileName(forestFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(topologyMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(topologyMeshIO->GetNumberOfCells(), 4);
+  // The first sample is not a root and still gets its cell
+  unsigned int forestCells[16];
+  topologyMeshIO->ReadCells(forestCells);
+  ITK_TEST_EXPECT_EQUAL(topologyMeshIO->GetCellBufferSize(), 16);
+  ITK_TEST_EXPECT_EQUAL(forestCells[0], static_cast<unsigned int>(itk::CommonEnums::CellGeometry::LINE_CELL));
+  ITK_TEST_EXPECT_EQUAL(forestCells[2], 1);
+  ITK_TEST_EXPECT_EQUAL(forestCells[3], 0);
+  ITK_TEST_EXPECT_EQUAL(forestCells[14], 4);
+  ITK_TEST_EXPECT_EQUAL(forestCells[15], 5);
+  const itk::SWCTopology & topology = topologyMeshIO->GetTopology();
+  using IndexContainerType = itk::SWCTopology::IndexContainerType;
+  ITK_TEST_EXPECT_EQUAL(topology.GetNumberOfPoints(), 7);
+  ITK_TEST_EXPECT_TRUE(topology.GetParentPointIndices() ==
+                       IndexContainerType({ 1,
+                                            itk::SWCTopology::InvalidIndex,
+                                            1,
+                                            0,
+                                            itk::SWCTopology::InvalidIndex,
+                                            4,
+                                            itk::SWCTopology::InvalidIndex }));
+  ITK_TEST_EXPECT_TRUE(topology.GetChildOffsets() == IndexContainerType({ 0, 1, 3, 3, 3, 4, 4, 4 }));
+  ITK_TEST_EXPECT_TRUE(topology.GetChildPointIndices() == IndexContainerType({ 3, 0, 2, 5 }));
+  ITK_TEST_EXPECT_EQUAL(topology.GetNumberOfChildren(1), 2);
+  ITK_TEST_EXPECT_EQUAL(*topology.BeginChildren(4), 5);
+  ITK_TEST_EXPECT_TRUE(topology.GetRootPointIndices() == IndexContainerType({ 1, 4, 6 }));
+  ITK_TEST_EXPECT_TRUE(topology.GetLeafPointIndices() == IndexContainerType({ 2, 3, 5, 6 }));
+  IndexContainerType order;
+  topology.DepthFirstOrder(order);
+  ITK_TEST_EXPECT_TRUE(order == IndexContainerType({ 1, 0, 3, 2, 4, 5, 6 }));
+  topology.BreadthFirstOrder(order);
+  ITK_TEST_EXPECT_TRUE(order == IndexContainerType({ 1, 4, 6, 0, 2, 5, 3 }));
+
+  // Samples renumbered in tree order, with the permutation back to the file
+  auto orderedMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_VALUE(itk::SWCMeshIOEnums::SWCSampleOrder::FileOrder, orderedMeshIO->GetSampleOrder());
+  orderedMeshIO->SetSampleOrder(itk::SWCMeshIOEnums::SWCSampleOrder::DepthFirst);
+  orderedMeshIO->SetFileName(forestFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(orderedMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(orderedMeshIO->GetPointPermutation() == IndexContainerType({ 1, 0, 3, 2, 4, 5, 6 }));
+  ITK_TEST_EXPECT_TRUE(orderedMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       std::vector<itk::SWCMeshIO::NativeIdentifierType>({ 20, 10, 40, 30, 50, 60, 70 }));
+  ITK_TEST_EXPECT_EQUAL(orderedMeshIO->GetTypeIdentifiers()->GetElement(0), 1);
+  ITK_TEST_EXPECT_EQUAL(orderedMeshIO->GetNumberOfCells(), 4);
+  unsigned int orderedCells[16];
+  orderedMeshIO->ReadCells(orderedCells);
+  std::vector<unsigned int> orderedEdges;
+  for (unsigned int ii = 0; ii < 4; ++ii)
+  {
+    orderedEdges.insert(orderedEdges.end(), orderedCells + 4 * ii + 2, orderedCells + 4 * ii + 4);
+  }
+  ITK_TEST_EXPECT_TRUE(orderedEdges == std::vector<unsigned int>({ 0, 1, 1, 2, 0, 3, 4, 5 }));
+  orderedMeshIO->SetSampleOrder(itk::SWCMeshIOEnums::SWCSampleOrder::BreadthFirst);
+  ITK_TRY_EXPECT_NO_EXCEPTION(orderedMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(orderedMeshIO->GetPointPermutation() == IndexContainerType({ 1, 4, 6, 0, 2, 5, 3 }));
+
+  // The writer emits the rows of file ordered samples in tree order
+  const std::string orderedFileName = outputDirectory + "/itkSWCMeshIOTestOrdered.swc";
+  auto orderedWriter = itk::SWCMeshIO::New();
+  orderedWriter->SetSampleOrder(itk::SWCMeshIOEnums::SWCSampleOrder::DepthFirst);
+  orderedWriter->SetFileName(orderedFileName);
+  orderedWriter->SetNumberOfPoints(topologyMeshIO->GetNumberOfPoints());
+  orderedWriter->SetPointComponentType(itk::IOComponentEnum::FLOAT);
+  orderedWriter->SetNativeSampleIdentifiers(topologyMeshIO->GetNativeSampleIdentifiers());
+  orderedWriter->SetNativeParentIdentifiers(topologyMeshIO->GetNativeParentIdentifiers());
+  ITK_TRY_EXPECT_NO_EXCEPTION(orderedWriter->WriteMeshInformation());
+  std::vector<float> forestPoints(3 * topologyMeshIO->GetNumberOfPoints());
+  topologyMeshIO->ReadPoints(forestPoints.data());
+  orderedWriter->WritePoints(static_cast<void *>(forestPoints.data()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(orderedWriter->Write());
+  topologyMeshIO->SetFileName(orderedFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(topologyMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(topologyMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       std::vector<itk::SWCMeshIO::NativeIdentifierType>({ 20, 10, 40, 30, 50, 60, 70 }));
+
+  // The containers of a reader are shared, const containers are copied
+  auto sharingMeshIO = itk::SWCMeshIO::New();
+  sharingMeshIO->SetRadii(swcMeshIO->GetRadii());
+  ITK_TEST_EXPECT_EQUAL(sharingMeshIO->GetRadii(), swcMeshIO->GetRadii());
+  const itk::SWCMeshIO * constMeshIO = swcMeshIO;
+  sharingMeshIO->SetRadii(constMeshIO->GetRadii());
+  ITK_TEST_EXPECT_EQUAL(sharingMeshIO->GetRadii(), swcMeshIO->GetRadii());
+  sharingMeshIO->SetTypeIdentifiers(constMeshIO->GetTypeIdentifiers());
+  ITK_TEST_EXPECT_TRUE(sharingMeshIO->GetTypeIdentifiers() != swcMeshIO->GetTypeIdentifiers());
+  ITK_TEST_EXPECT_TRUE(sharingMeshIO->GetTypeIdentifiers()->CastToSTLConstContainer() ==
+                       swcMeshIO->GetTypeIdentifiers()->CastToSTLConstContainer());
+
+  // Non-const containers are shared, and copied before writing into them
+  auto sharedSampleIdentifiers = itk::SWCMeshIO::NativeIdentifierContainerType::New();
+  sharedSampleIdentifiers->CastToSTLContainer() = { 1, 2, 3, 4 };
+  auto sharedRadii = itk::SWCMeshIO::RadiusContainerType::New();
+  sharedRadii->CastToSTLContainer() = { 0.5, 0.5, 0.5, 0.5 };
+  sharingMeshIO->SetNativeSampleIdentifiers(sharedSampleIdentifiers);
+  sharingMeshIO->SetRadii(sharedRadii);
+  ITK_TEST_EXPECT_EQUAL(sharingMeshIO->GetNativeSampleIdentifiers(), sharedSampleIdentifiers.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(sharingMeshIO->GetRadii(), sharedRadii.GetPointer());
+  sharingMeshIO->SetNumberOfPoints(4);
+  sharingMeshIO->SetPointDataContent(itk::SWCMeshIOEnums::SWCPointData::Radius);
+  sharingMeshIO->SetPointPixelComponentType(itk::IOComponentEnum::DOUBLE);
+  double writtenRadii[4] = { 9.0, 9.0, 9.0, 9.0 };
+  sharingMeshIO->WritePointData(static_cast<void *>(writtenRadii));
+  ITK_TEST_EXPECT_TRUE(sharingMeshIO->GetRadii() != sharedRadii.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(sharingMeshIO->GetRadii()->GetElement(0), 9.0);
+  ITK_TEST_EXPECT_EQUAL(sharedRadii->GetElement(0), 0.5);
+  ITK_TEST_EXPECT_EQUAL(sharingMeshIO->GetNativeSampleIdentifiers(), sharedSampleIdentifiers.GetPointer());
+  std::vector<itk::SWCMeshIO::RadiusType> movedRadii(4, 2.0);
+  const double *                          movedRadiiData = movedRadii.data();
+  sharingMeshIO->SetRadii(std::move(movedRadii));
+  ITK_TEST_EXPECT_EQUAL(sharingMeshIO->GetRadii()->CastToSTLConstContainer().data(), movedRadiiData);
+
+  // Buffers handed out through the MeshIOBase interface are released
+  auto releasingMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(releasingMeshIO, ReleaseBuffersAfterRead, true);
+  releasingMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(releasingMeshIO->ReadMeshInformation());
+  ITK_TRY_EXPECT_NO_EXCEPTION(releasingMeshIO->ReadPoints(points));
+  ITK_TEST_EXPECT_EQUAL(points[6], 2.5f);
+  ITK_TRY_EXPECT_EXCEPTION(releasingMeshIO->ReadPoints(points));
+  float typeIdentifiers[4];
+  ITK_TRY_EXPECT_NO_EXCEPTION(releasingMeshIO->ReadPointData(typeIdentifiers));
+  ITK_TEST_EXPECT_EQUAL(typeIdentifiers[3], 2.0f);
+  ITK_TEST_EXPECT_EQUAL(releasingMeshIO->GetRadii()->Size(), 0);
+
+  // Samples are moved into a mesh, the radii without a copy
+  using MeshType = itk::Mesh<double, 3>;
+  auto meshIO = itk::SWCMeshIO::New();
+  meshIO->SetPointDataContent(itk::SWCMeshIOEnums::SWCPointData::Radius);
+  meshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshIO->ReadMeshInformation());
+  const double * radii = meshIO->GetRadii()->CastToSTLConstContainer().data();
+  auto           mesh = MeshType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshIO->TransferToMesh(mesh.GetPointer()));
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), 4);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetPoints()->GetElement(2)[0], 2.5f);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetPointData()->CastToSTLConstContainer().data(), radii);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetPointData()->GetElement(1), 0.75);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), 3);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCells()->GetElement(2)->PointIdsBegin()[0], 0);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCells()->GetElement(2)->PointIdsBegin()[1], 3);
+  ITK_TEST_EXPECT_EQUAL(meshIO->GetRadii()->Size(), 0);
+  ITK_TRY_EXPECT_EXCEPTION(meshIO->TransferToMesh(mesh.GetPointer()));
+
+  // Requested component types are read directly, and double coordinates
+  // keep the digits that float rounds away
+  const std::string preciseFileName = outputDirectory + "/itkSWCMeshIOTestPrecise.swc";
+  {
+    std::ofstream outputFile(preciseFileName.c_str(), std::ios::out);
+    outputFile << "1 1 16777217.5 0.1 0 1 -1\n"
+               << "2 3 16777219.25 0.2 0 1.5 1\n"
+               << "3 3 16777221.125 0.3 0 2 1\n";
+  }
+  auto preciseMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_VALUE(itk::IOComponentEnum::UNKNOWNCOMPONENTTYPE, preciseMeshIO->GetRequestedPointComponentType());
+  preciseMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::DOUBLE);
+  preciseMeshIO->SetRequestedCellComponentType(itk::IOComponentEnum::LONGLONG);
+  preciseMeshIO->SetRequestedPointPixelComponentType(itk::IOComponentEnum::DOUBLE);
+  preciseMeshIO->SetSampleOrder(itk::SWCMeshIOEnums::SWCSampleOrder::DepthFirst);
+  preciseMeshIO->SetFileName(preciseFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(preciseMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(preciseMeshIO->GetPointComponentType() == itk::IOComponentEnum::DOUBLE);
+  ITK_TEST_EXPECT_TRUE(preciseMeshIO->GetCellComponentType() == itk::IOComponentEnum::LONGLONG);
+  ITK_TEST_EXPECT_TRUE(preciseMeshIO->GetPointPixelComponentType() == itk::IOComponentEnum::DOUBLE);
+  double precisePoints[9];
+  ITK_TRY_EXPECT_NO_EXCEPTION(preciseMeshIO->ReadPoints(precisePoints));
+  ITK_TEST_EXPECT_EQUAL(precisePoints[0], 16777217.5);
+  ITK_TEST_EXPECT_EQUAL(precisePoints[4], 0.2);
+  ITK_TEST_EXPECT_EQUAL(precisePoints[6], 16777221.125);
+  long long preciseCells[8];
+  ITK_TRY_EXPECT_NO_EXCEPTION(preciseMeshIO->ReadCells(preciseCells));
+  ITK_TEST_EXPECT_EQUAL(preciseCells[3], 1);
+  ITK_TEST_EXPECT_EQUAL(preciseCells[7], 2);
+  double preciseTypeIdentifiers[3];
+  ITK_TRY_EXPECT_NO_EXCEPTION(preciseMeshIO->ReadPointData(preciseTypeIdentifiers));
+  ITK_TEST_EXPECT_EQUAL(preciseTypeIdentifiers[0], 1.0);
+
+  // The precision is kept through the cache, a parallel parse and a write
+  auto parallelPreciseMeshIO = itk::SWCMeshIO::New();
+  parallelPreciseMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::DOUBLE);
+  parallelPreciseMeshIO->SetNumberOfWorkUnits(2);
+  parallelPreciseMeshIO->SetFileName(preciseFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelPreciseMeshIO->ReadMeshInformation());
+  using PreciseMeshType = itk::Mesh<double, 3, itk::DefaultStaticMeshTraits<double, 3, 3, double>>;
+  auto preciseMesh = PreciseMeshType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelPreciseMeshIO->TransferToMesh(preciseMesh.GetPointer()));
+  ITK_TEST_EXPECT_EQUAL(preciseMesh->GetPoints()->GetElement(1)[0], 16777219.25);
+
+  const std::string preciseOutputFileName = outputDirectory + "/itkSWCMeshIOTestPreciseOutput.swc";
+  auto              preciseWriterMeshIO = itk::SWCMeshIO::New();
+  preciseWriterMeshIO->SetFileName(preciseOutputFileName);
+  preciseWriterMeshIO->SetNumberOfPoints(3);
+  preciseWriterMeshIO->SetPointComponentType(itk::IOComponentEnum::DOUBLE);
+  preciseWriterMeshIO->WritePoints(static_cast<void *>(precisePoints));
+  ITK_TRY_EXPECT_NO_EXCEPTION(preciseWriterMeshIO->Write());
+  preciseMeshIO->SetSampleOrder(itk::SWCMeshIOEnums::SWCSampleOrder::FileOrder);
+  preciseMeshIO->SetFileName(preciseOutputFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(preciseMeshIO->ReadMeshInformation());
+  ITK_TRY_EXPECT_NO_EXCEPTION(preciseMeshIO->ReadPoints(precisePoints));
+  ITK_TEST_EXPECT_EQUAL(precisePoints[3], 16777219.25);
+
+  // The geometry of the segments is read as cell data
+  auto geometryMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_VALUE(itk::SWCMeshIOEnums::SWCCellData::NoCellData, geometryMeshIO->GetCellDataContent());
+  geometryMeshIO->SetCellDataContent(itk::SWCMeshIOEnums::SWCCellData::AllGeometry);
+  geometryMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(geometryMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(geometryMeshIO->GetNumberOfCellPixels(), 3);
+  ITK_TEST_EXPECT_TRUE(geometryMeshIO->GetCellPixelType() == itk::IOPixelEnum::VECTOR);
+  ITK_TEST_EXPECT_EQUAL(geometryMeshIO->GetNumberOfCellPixelComponents(), 3);
+  ITK_TEST_EXPECT_TRUE(geometryMeshIO->GetCellPixelComponentType() == itk::IOComponentEnum::DOUBLE);
+  double geometry[9];
+  ITK_TRY_EXPECT_NO_EXCEPTION(geometryMeshIO->ReadCellData(geometry));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(geometry[0], std::sqrt(2.5625)));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(geometry[3], std::sqrt(2.0)));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(geometry[4], itk::Math::pi / 3.0 * std::sqrt(2.0) * 1.1875));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(geometry[5], itk::Math::pi * 1.25 * std::sqrt(2.0625)));
+
+  geometryMeshIO->SetCellDataContent(itk::SWCMeshIOEnums::SWCCellData::Volume);
+  ITK_TRY_EXPECT_NO_EXCEPTION(geometryMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(geometryMeshIO->GetCellPixelType() == itk::IOPixelEnum::SCALAR);
+  auto geometryMesh = MeshType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(geometryMeshIO->TransferToMesh(geometryMesh.GetPointer()));
+  ITK_TEST_EXPECT_EQUAL(geometryMesh->GetCellData()->Size(), 3);
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(geometryMesh->GetCellData()->GetElement(1), geometry[4]));
+
+  // Only the samples inside the region of interest are kept. Sample 4 is
+  // inside once padded by its radius, and the parent of sample 8 follows it.
+  const std::string regionFileName = outputDirectory + "/itkSWCMeshIOTestRegion.swc";
+  {
+    std::ofstream outputFile(regionFileName.c_str(), std::ios::out);
+    outputFile << "1 1 0 0 0 2 -1\n"
+               << "2 3 5 0 0 1 1\n"
+               << "3 3 12 0 0 1 2\n"
+               << "4 3 10.5 0 0 1 2\n"
+               << "5 3 20 0 0 1 3\n"
+               << "6 2 -3 0 0 1 1\n"
+               << "7 2 -5 0 0 1 6\n"
+               << "8 2 5 0.5 0 1 9\n"
+               << "9 2 5 5 0 1 -1\n";
+  }
+  auto regionMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(regionMeshIO, UseRegionOfInterest, false);
+  ITK_TEST_SET_GET_BOOLEAN(regionMeshIO, PadRegionOfInterestByRadius, false);
+  ITK_TEST_SET_GET_VALUE(itk::SWCMeshIOEnums::SWCRegionBoundary::DetachParents,
+                         regionMeshIO->GetRegionOfInterestBoundary());
+  const itk::SWCMeshIO::RegionOfInterestBoundType regionMinimum{ { -1.0, -1.0, -1.0 } };
+  const itk::SWCMeshIO::RegionOfInterestBoundType regionMaximum{ { 10.0, 1.0, 1.0 } };
+  regionMeshIO->SetRegionOfInterestMinimum(regionMinimum);
+  regionMeshIO->SetRegionOfInterestMaximum(regionMaximum);
+  ITK_TEST_EXPECT_TRUE(regionMeshIO->GetRegionOfInterestMaximum() == regionMaximum);
+  regionMeshIO->UseRegionOfInterestOn();
+  regionMeshIO->SetFileName(regionFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNumberOfPoints(), 3);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNumberOfCells(), 1);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNativeSampleIdentifiers()->GetElement(2), 8);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNativeParentIdentifiers()->GetElement(2), -1);
+
+  regionMeshIO->PadRegionOfInterestByRadiusOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNumberOfPoints(), 4);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNumberOfCells(), 2);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNativeSampleIdentifiers()->GetElement(2), 4);
+
+  // Boundary samples are kept in file order, linked to the samples inside
+  const std::vector<itk::SWCMeshIO::NativeIdentifierType> boundaryIdentifiers{ 1, 2, 3, 4, 6, 8, 9 };
+  const std::vector<itk::SWCMeshIO::NativeIdentifierType> boundaryParents{ -1, 1, 2, 2, 1, 9, -1 };
+  regionMeshIO->PadRegionOfInterestByRadiusOff();
+  regionMeshIO->SetRegionOfInterestBoundary(itk::SWCMeshIOEnums::SWCRegionBoundary::KeepBoundarySamples);
+  regionMeshIO->ValidateSamplesOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(regionMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() == boundaryIdentifiers);
+  ITK_TEST_EXPECT_TRUE(regionMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() == boundaryParents);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetNumberOfCells(), 5);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetValidationReport().GetNumberOfMissingParents(), 0);
+  ITK_TEST_EXPECT_EQUAL(regionMeshIO->GetValidationReport().GetNumberOfCycles(), 0);
+
+  auto parallelRegionMeshIO = itk::SWCMeshIO::New();
+  parallelRegionMeshIO->SetNumberOfWorkUnits(3);
+  parallelRegionMeshIO->UseRegionOfInterestOn();
+  parallelRegionMeshIO->SetRegionOfInterestMinimum(regionMinimum);
+  parallelRegionMeshIO->SetRegionOfInterestMaximum(regionMaximum);
+  parallelRegionMeshIO->SetRegionOfInterestBoundary(itk::SWCMeshIOEnums::SWCRegionBoundary::KeepBoundarySamples);
+  parallelRegionMeshIO->SetFileName(regionFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelRegionMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(parallelRegionMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       boundaryIdentifiers);
+  ITK_TEST_EXPECT_TRUE(parallelRegionMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       boundaryParents);
+
+  // Only the subtree of the root sample is kept and renumbered. Sample 7
+  // refers to its parent before it is defined.
+  const std::string subtreeFileName = outputDirectory + "/itkSWCMeshIOTestSubtree.swc";
+  {
+    std::ofstream outputFile(subtreeFileName.c_str(), std::ios::out);
+    outputFile << "1 1 0 0 0 1 -1\n"
+               << "2 3 1 0 0 1 1\n"
+               << "3 3 2 0 0 1 2\n"
+               << "4 2 -1 0 0 1 1\n"
+               << "5 2 -2 0 0 1 4\n"
+               << "6 3 -3 0 0 1 5\n"
+               << "7 2 -2 1 0 1 9\n"
+               << "9 2 -2 2 0 1 5\n";
+  }
+  using NativeIdentifierContainerType = std::vector<itk::SWCMeshIO::NativeIdentifierType>;
+  auto subtreeMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_VALUE(-1, subtreeMeshIO->GetSubtreeRootIdentifier());
+  ITK_TEST_EXPECT_TRUE(subtreeMeshIO->GetSubtreeTypeIdentifiers().empty());
+  subtreeMeshIO->SetSubtreeRootIdentifier(4);
+  subtreeMeshIO->SetFileName(subtreeFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(subtreeMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNumberOfPoints(), 5);
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNumberOfCells(), 4);
+  ITK_TEST_EXPECT_TRUE(subtreeMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ 1, 2, 3, 4, 5 }));
+  ITK_TEST_EXPECT_TRUE(subtreeMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ -1, 1, 2, 5, 2 }));
+  float subtreePoints[15];
+  ITK_TRY_EXPECT_NO_EXCEPTION(subtreeMeshIO->ReadPoints(subtreePoints));
+  ITK_TEST_EXPECT_EQUAL(subtreePoints[6], -3.0f);
+  float subtreeTypeIdentifiers[5];
+  ITK_TRY_EXPECT_NO_EXCEPTION(subtreeMeshIO->ReadPointData(subtreeTypeIdentifiers));
+  ITK_TEST_EXPECT_EQUAL(subtreeTypeIdentifiers[0], 2.0f);
+  ITK_TEST_EXPECT_EQUAL(subtreeTypeIdentifiers[2], 3.0f);
+  unsigned int subtreeCells[16];
+  ITK_TRY_EXPECT_NO_EXCEPTION(subtreeMeshIO->ReadCells(subtreeCells));
+  std::vector<unsigned int> subtreeEdges;
+  for (unsigned int ii = 0; ii < 4; ++ii)
+  {
+    subtreeEdges.insert(subtreeEdges.end(), subtreeCells + 4 * ii + 2, subtreeCells + 4 * ii + 4);
+  }
+  ITK_TEST_EXPECT_TRUE(subtreeEdges == std::vector<unsigned int>({ 0, 1, 1, 2, 4, 3, 1, 4 }));
+
+  // The axon type selects the same subtree, the type of the dendrites the
+  // samples 2, 3 and 6, where 6 is detached
+  subtreeMeshIO->SetSubtreeRootIdentifier(-1);
+  subtreeMeshIO->SetSubtreeTypeIdentifiers({ 2 });
+  ITK_TRY_EXPECT_NO_EXCEPTION(subtreeMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(subtreeMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ -1, 1, 2, 5, 2 }));
+  subtreeMeshIO->SetSubtreeTypeIdentifiers({ 3 });
+  ITK_TRY_EXPECT_NO_EXCEPTION(subtreeMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNumberOfPoints(), 3);
+  ITK_TEST_EXPECT_EQUAL(subtreeMeshIO->GetNumberOfCells(), 1);
+  ITK_TEST_EXPECT_TRUE(subtreeMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ -1, 1, -1 }));
+
+  // A root sample that is not in the file is an error
+  subtreeMeshIO->SetSubtreeTypeIdentifiers({});
+  subtreeMeshIO->SetSubtreeRootIdentifier(8);
+  ITK_TRY_EXPECT_EXCEPTION(subtreeMeshIO->ReadMeshInformation());
+
+  // Unbranched sections are merged into polylines, from the parent end
+  auto polyLineMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(polyLineMeshIO, UsePolyLineCells, false);
+  polyLineMeshIO->SetFileName(subtreeFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(polyLineMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(polyLineMeshIO->GetNumberOfCells(), 7);
+  ITK_TEST_EXPECT_EQUAL(polyLineMeshIO->GetCellBufferSize(), 28);
+  polyLineMeshIO->UsePolyLineCellsOn();
+  polyLineMeshIO->SetCellDataContent(itk::SWCMeshIOEnums::SWCCellData::Length);
+  ITK_TRY_EXPECT_NO_EXCEPTION(polyLineMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(polyLineMeshIO->GetNumberOfCells(), 4);
+  ITK_TEST_EXPECT_EQUAL(polyLineMeshIO->GetCellBufferSize(), 19);
+  const auto polyLineCellType = static_cast<unsigned int>(itk::CommonEnums::CellGeometry::POLYLINE_CELL);
+  std::vector<unsigned int> polyLineCells(polyLineMeshIO->GetCellBufferSize());
+  ITK_TRY_EXPECT_NO_EXCEPTION(polyLineMeshIO->ReadCells(polyLineCells.data()));
+  ITK_TEST_EXPECT_TRUE(polyLineCells == std::vector<unsigned int>({ polyLineCellType, 3, 0, 1, 2,
+                                                                    polyLineCellType, 3, 0, 3, 4,
+                                                                    polyLineCellType, 2, 4, 5,
+                                                                    polyLineCellType, 3, 4, 7, 6 }));
+  double polyLineLengths[4];
+  ITK_TRY_EXPECT_NO_EXCEPTION(polyLineMeshIO->ReadCellData(polyLineLengths));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(polyLineLengths[0], 2.0));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(polyLineLengths[3], 3.0));
+
+  // The writer expands the polylines back to parent identifiers
+  auto polyLineWriter = itk::SWCMeshIO::New();
+  polyLineWriter->SetNumberOfPoints(polyLineMeshIO->GetNumberOfPoints());
+  polyLineWriter->SetNativeSampleIdentifiers(polyLineMeshIO->GetNativeSampleIdentifiers());
+  polyLineWriter->SetNumberOfCells(polyLineMeshIO->GetNumberOfCells());
+  polyLineWriter->SetCellBufferSize(polyLineMeshIO->GetCellBufferSize());
+  polyLineWriter->SetCellComponentType(itk::IOComponentEnum::UINT);
+  ITK_TRY_EXPECT_NO_EXCEPTION(polyLineWriter->WriteCells(static_cast<void *>(polyLineCells.data())));
+  ITK_TEST_EXPECT_TRUE(polyLineWriter->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ -1, 1, 2, 1, 4, 5, 9, 5 }));
+  polyLineCells[14] = static_cast<unsigned int>(itk::CommonEnums::CellGeometry::TRIANGLE_CELL);
+  ITK_TRY_EXPECT_EXCEPTION(polyLineWriter->WriteCells(static_cast<void *>(polyLineCells.data())));
+
+  auto polyLineMesh = MeshType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(polyLineMeshIO->TransferToMesh(polyLineMesh.GetPointer()));
+  ITK_TEST_EXPECT_EQUAL(polyLineMesh->GetNumberOfCells(), 4);
+  ITK_TEST_EXPECT_EQUAL(polyLineMesh->GetCells()->GetElement(3)->GetNumberOfPoints(), 3);
+  ITK_TEST_EXPECT_EQUAL(polyLineMesh->GetCells()->GetElement(3)->PointIdsBegin()[1], 7);
+
+  // Decimation removes the samples of unbranched sections that are within
+  // tolerance in position and radius. Sample 2 follows the soma and sample 4
+  // is a branch point, and sample 6 is kept where the radius grows.
+  const std::string decimationFileName = outputDirectory + "/itkSWCMeshIOTestDecimation.swc";
+  {
+    std::ofstream outputFile(decimationFileName.c_str(), std::ios::out);
+    outputFile << "1 1 0 0 0 2 -1\n"
+               << "2 3 1 0 0 2 1\n"
+               << "3 3 2 0.05 0 2 2\n"
+               << "4 3 3 0 0 2 3\n"
+               << "5 3 4 0 0 2 4\n"
+               << "6 3 5 1 0 2.5 5\n"
+               << "7 3 6 2 0 2.5 6\n"
+               << "8 3 7 3 0 2.5 7\n"
+               << "9 3 3 -1 0 2 4\n";
+  }
+  auto decimationMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_VALUE(0.0, decimationMeshIO->GetDecimationTolerance());
+  ITK_TEST_SET_GET_BOOLEAN(decimationMeshIO, ScaleDecimationToleranceByRadius, false);
+  decimationMeshIO->SetDecimationTolerance(0.1);
+  decimationMeshIO->SetFileName(decimationFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(decimationMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(decimationMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ 1, 2, 4, 5, 6, 8, 9 }));
+  ITK_TEST_EXPECT_TRUE(decimationMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ -1, 1, 2, 4, 5, 6, 4 }));
+  ITK_TEST_EXPECT_EQUAL(decimationMeshIO->GetNumberOfCells(), 6);
+  decimationMeshIO->SetDecimationTolerance(0.04);
+  ITK_TRY_EXPECT_NO_EXCEPTION(decimationMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(decimationMeshIO->GetNumberOfPoints(), 8);
+  decimationMeshIO->ScaleDecimationToleranceByRadiusOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(decimationMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(decimationMeshIO->GetNumberOfPoints(), 7);
+
+  // One segment replaces at most MaximumDecimationWindow samples
+  const std::string straightFileName = outputDirectory + "/itkSWCMeshIOTestStraight.swc";
+  {
+    std::ofstream outputFile(straightFileName.c_str(), std::ios::out);
+    for (int ii = 1; ii <= 200; ++ii)
+    {
+      outputFile << ii << " 3 " << ii << " 0 0 1 " << (ii == 1 ? -1 : ii - 1) << '\n';
+    }
+  }
+  decimationMeshIO->SetFileName(straightFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(decimationMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(decimationMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ 1, 66, 131, 196, 200 }));
+  ITK_TEST_EXPECT_TRUE(decimationMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       NativeIdentifierContainerType({ -1, 1, 66, 131, 196 }));
+
+  // A truncated sample is reported instead of being silently accepted
+  const std::string invalidFileName = outputDirectory + "/itkSWCMeshIOTestInvalid.swc";
+  {
+    std::ofstream outputFile(invalidFileName.c_str(), std::ios::out);
+    outputFile << "1 1 0 0 0 1 -1\n"
+               << "2 3 1 0 0\n";
+  }
+  swcMeshIO->SetFileName(invalidFileName);
+  ITK_TRY_EXPECT_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  parallelMeshIO->SetFileName(invalidFileName);
+  ITK_TRY_EXPECT_EXCEPTION(parallelMeshIO->ReadMeshInformation());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,317 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMath.h"
+#include "itkSWCMeshIO.h"
+#include "itkSWCMorphometrics.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace
+{
+bool
+IsClose(double value, double expected)
+{
+  return std::abs(value - expected) <= 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+// Measures computed from the text of an SWC file, independently of
+// SWCParser, of the cells of SWCMeshIO and of the frustum formulas of
+// SWCMorphometrics: the surface area and the volume of each segment are
+// integrated along its axis with Simpson's rule, which is exact for the
+// linear and quadratic integrands of a frustum
+struct ReferenceMeasures
+{
+  double             Length{ 0.0 };
+  double             SurfaceArea{ 0.0 };
+  double             Volume{ 0.0 };
+  itk::SizeValueType NumberOfSamples{ 0 };
+  itk::SizeValueType NumberOfRoots{ 0 };
+  itk::SizeValueType NumberOfTips{ 0 };
+  itk::SizeValueType NumberOfBranchPoints{ 0 };
+  double             MinimumPoint[3]{ 0.0, 0.0, 0.0 };
+  double             MaximumPoint[3]{ 0.0, 0.0, 0.0 };
+};
+
+ReferenceMeasures
+ComputeReferenceMeasures(const std::string & fileName)
+{
+  struct Sample
+  {
+    double    Point[3];
+    double    Radius;
+    long long Parent;
+  };
+  std::vector<Sample>           samples;
+  std::map<long long, size_t>   sampleIndices;
+  std::ifstream                 inputFile(fileName.c_str());
+  std::string                   line;
+  while (std::getline(inputFile, line))
+  {
+    std::istringstream fields(line);
+    long long          identifier = 0;
+    double             type = 0.0;
+    Sample             sample{};
+    if (line.find('#') != std::string::npos ||
+        !(fields >> identifier >> type >> sample.Point[0] >> sample.Point[1] >> sample.Point[2] >> sample.Radius >>
+          sample.Parent))
+    {
+      continue;
+    }
+    sampleIndices[identifier] = samples.size();
+    samples.push_back(sample);
+  }
+
+  ReferenceMeasures   measures;
+  std::vector<size_t> numberOfChildren(samples.size());
+  measures.NumberOfSamples = samples.size();
+  for (const auto & sample : samples)
+  {
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      const bool first = &sample == samples.data();
+      measures.MinimumPoint[jj] = first ? sample.Point[jj] : std::min(measures.MinimumPoint[jj], sample.Point[jj]);
+      measures.MaximumPoint[jj] = first ? sample.Point[jj] : std::max(measures.MaximumPoint[jj], sample.Point[jj]);
+    }
+    const auto parent = sampleIndices.find(sample.Parent);
+    if (parent == sampleIndices.end())
+    {
+      ++measures.NumberOfRoots;
+      continue;
+    }
+    const Sample & parentSample = samples[parent->second];
+    double         squaredLength = 0.0;
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      squaredLength += (sample.Point[jj] - parentSample.Point[jj]) * (sample.Point[jj] - parentSample.Point[jj]);
+    }
+    const double length = std::sqrt(squaredLength);
+    const double radiusSlope = sample.Radius - parentSample.Radius;
+    const double slantLength = std::sqrt(squaredLength + radiusSlope * radiusSlope);
+    const double radii[3] = { parentSample.Radius, 0.5 * (parentSample.Radius + sample.Radius), sample.Radius };
+    measures.Length += length;
+    measures.SurfaceArea += 2.0 * itk::Math::pi * slantLength * (radii[0] + 4.0 * radii[1] + radii[2]) / 6.0;
+    measures.Volume += itk::Math::pi * length *
+                       (radii[0] * radii[0] + 4.0 * radii[1] * radii[1] + radii[2] * radii[2]) / 6.0;
+    ++numberOfChildren[parent->second];
+  }
+  for (const auto count : numberOfChildren)
+  {
+    measures.NumberOfTips += count == 0;
+    measures.NumberOfBranchPoints += count >= 2;
+  }
+  return measures;
+}
+
+// Compare the measures of morphometrics with the reference measures
+int
+ExpectReferenceMeasures(const itk::SWCMorphometrics & morphometrics, const ReferenceMeasures & reference)
+{
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfSamples(), reference.NumberOfSamples);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfRoots(), reference.NumberOfRoots);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfTips(), reference.NumberOfTips);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfBranchPoints(), reference.NumberOfBranchPoints);
+  ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetTotalLength(), reference.Length));
+  ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetTotalSurfaceArea(), reference.SurfaceArea));
+  ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetTotalVolume(), reference.Volume));
+  for (unsigned int jj = 0; jj < 3; ++jj)
+  {
+    ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetMinimumPoint()[jj], reference.MinimumPoint[jj]));
+    ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetMaximumPoint()[jj], reference.MaximumPoint[jj]));
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkSWCMorphometricsTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory [inputFile ...]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // A soma with two branches, the second of which bifurcates
+  const std::string fileName = outputDirectory + "/itkSWCMorphometricsTest.swc";
+  {
+    std::ofstream outputFile(fileName.c_str(), std::ios::out);
+    outputFile << "1 1 0 0 0 1 -1\n"
+               << "2 3 3 4 0 1 1\n"
+               << "3 3 3 4 12 1 2\n"
+               << "4 2 0 0 -2 0.5 1\n"
+               << "5 3 6 8 0 1 2\n";
+  }
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  swcMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  itk::SWCMorphometrics morphometrics;
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ComputeMorphometrics(morphometrics));
+
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfSamples(), 5);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfRoots(), 1);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfBranchPoints(), 2);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetNumberOfTips(), 3);
+  ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetTotalLength(), 24.0));
+  ITK_TEST_EXPECT_TRUE(
+    IsClose(morphometrics.GetTotalSurfaceArea(), itk::Math::pi * (44.0 + 1.5 * std::sqrt(4.25))));
+  ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetTotalVolume(), itk::Math::pi * (22.0 + 7.0 / 6.0)));
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetMinimumPoint()[2], -2.0);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetMaximumPoint()[1], 8.0);
+  ITK_TEST_EXPECT_EQUAL(morphometrics.GetMaximumPoint()[2], 12.0);
+
+  const auto & typeMeasures = morphometrics.GetTypeMeasures();
+  ITK_TEST_EXPECT_EQUAL(typeMeasures.size(), 3);
+  ITK_TEST_EXPECT_EQUAL(typeMeasures[0].TypeIdentifier, 1.0f);
+  ITK_TEST_EXPECT_EQUAL(typeMeasures[0].Length, 0.0);
+  ITK_TEST_EXPECT_EQUAL(typeMeasures[1].TypeIdentifier, 2.0f);
+  ITK_TEST_EXPECT_TRUE(IsClose(typeMeasures[1].Volume, itk::Math::pi * 7.0 / 6.0));
+  ITK_TEST_EXPECT_EQUAL(typeMeasures[2].NumberOfSamples, 3);
+  ITK_TEST_EXPECT_TRUE(IsClose(typeMeasures[2].Length, 22.0));
+  ITK_TEST_EXPECT_TRUE(IsClose(typeMeasures[2].SurfaceArea, itk::Math::pi * 44.0));
+  morphometrics.Print(std::cout);
+
+  // Type identifiers outside of the range of the type table, negative or
+  // fractional, are measured separately
+  const std::string typesFileName = outputDirectory + "/itkSWCMorphometricsTestTypes.swc";
+  {
+    std::ofstream outputFile(typesFileName.c_str(), std::ios::out);
+    outputFile << "1 -3 0 0 0 1 -1\n"
+               << "2 1e30 0 0 2 1 1\n"
+               << "3 2.5 0 0 5 1 2\n"
+               << "4 1e30 0 0 9 1 3\n";
+  }
+  auto typesMeshIO = itk::SWCMeshIO::New();
+  typesMeshIO->SetFileName(typesFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(typesMeshIO->ReadMeshInformation());
+  itk::SWCMorphometrics typesMorphometrics;
+  ITK_TRY_EXPECT_NO_EXCEPTION(typesMeshIO->ComputeMorphometrics(typesMorphometrics));
+  const auto & otherTypeMeasures = typesMorphometrics.GetTypeMeasures();
+  ITK_TEST_EXPECT_EQUAL(otherTypeMeasures.size(), 3);
+  ITK_TEST_EXPECT_EQUAL(otherTypeMeasures[0].TypeIdentifier, -3.0f);
+  ITK_TEST_EXPECT_EQUAL(otherTypeMeasures[1].TypeIdentifier, 2.5f);
+  ITK_TEST_EXPECT_TRUE(IsClose(otherTypeMeasures[1].Length, 3.0));
+  ITK_TEST_EXPECT_EQUAL(otherTypeMeasures[2].TypeIdentifier, 1e30f);
+  ITK_TEST_EXPECT_EQUAL(otherTypeMeasures[2].NumberOfSamples, 2);
+  ITK_TEST_EXPECT_TRUE(IsClose(otherTypeMeasures[2].Length, 6.0));
+
+  // Double precision points and the parent indices of the topology give
+  // the same measures
+  swcMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::DOUBLE);
+  swcMeshIO->ComputeTopologyOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  itk::SWCMorphometrics doubleMorphometrics;
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ComputeMorphometrics(doubleMorphometrics));
+  ITK_TEST_EXPECT_EQUAL(doubleMorphometrics.GetNumberOfBranchPoints(), 2);
+  ITK_TEST_EXPECT_TRUE(IsClose(doubleMorphometrics.GetTotalLength(), morphometrics.GetTotalLength()));
+  ITK_TEST_EXPECT_TRUE(IsClose(doubleMorphometrics.GetTotalVolume(), morphometrics.GetTotalVolume()));
+  swcMeshIO->ReleaseBuffers();
+  ITK_TRY_EXPECT_EXCEPTION(swcMeshIO->ComputeMorphometrics(doubleMorphometrics));
+
+  // A larger tree is split across work units
+  const std::string       largeFileName = outputDirectory + "/itkSWCMorphometricsTestLarge.swc";
+  constexpr unsigned int  numberOfLargeSamples = 20000;
+  {
+    std::ofstream outputFile(largeFileName.c_str(), std::ios::out);
+    for (unsigned int ii = 1; ii <= numberOfLargeSamples; ++ii)
+    {
+      outputFile << ii << ' ' << 2 + ii % 3 << ' ' << 0.5 * ii << ' ' << ii % 7 << ' ' << ii % 11 << ' '
+                 << 0.25 + 0.01 * (ii % 13) << ' ' << (ii == 1 ? -1 : static_cast<int>(ii / 2)) << '\n';
+    }
+  }
+  auto largeMeshIO = itk::SWCMeshIO::New();
+  largeMeshIO->SetFileName(largeFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(largeMeshIO->ReadMeshInformation());
+  itk::SWCMorphometrics parallelMorphometrics;
+  parallelMorphometrics.SetNumberOfWorkUnits(4);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetNumberOfWorkUnits(), 4);
+  largeMeshIO->ComputeMorphometrics(morphometrics);
+  largeMeshIO->ComputeMorphometrics(parallelMorphometrics);
+  const ReferenceMeasures reference = ComputeReferenceMeasures(largeFileName);
+  ITK_TEST_EXPECT_EQUAL(ExpectReferenceMeasures(parallelMorphometrics, reference), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_TRUE(IsClose(morphometrics.GetTotalVolume(), reference.Volume));
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetTypeMeasures().size(), 3);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetTypeMeasures()[1].NumberOfSamples,
+                        morphometrics.GetTypeMeasures()[1].NumberOfSamples);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetMaximumPoint()[0], 0.5 * numberOfLargeSamples);
+
+  // A complete binary tree of 14 levels, whose segments all have length 5
+  // and radius 1, has closed-form measures
+  const std::string      binaryTreeFileName = outputDirectory + "/itkSWCMorphometricsTestBinaryTree.swc";
+  constexpr unsigned int numberOfTreeSamples = (1u << 15) - 1;
+  {
+    std::vector<int> x(numberOfTreeSamples + 1);
+    std::vector<int> y(numberOfTreeSamples + 1);
+    std::ofstream    outputFile(binaryTreeFileName.c_str(), std::ios::out);
+    for (unsigned int ii = 1; ii <= numberOfTreeSamples; ++ii)
+    {
+      if (ii > 1)
+      {
+        x[ii] = x[ii / 2] + 3;
+        y[ii] = y[ii / 2] + (ii % 2 ? -4 : 4);
+      }
+      outputFile << ii << ' ' << 2 + ii % 2 << ' ' << x[ii] << ' ' << y[ii] << " 0 1 "
+                 << (ii == 1 ? -1 : static_cast<int>(ii / 2)) << '\n';
+    }
+  }
+  auto binaryTreeMeshIO = itk::SWCMeshIO::New();
+  binaryTreeMeshIO->SetFileName(binaryTreeFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(binaryTreeMeshIO->ReadMeshInformation());
+  ITK_TRY_EXPECT_NO_EXCEPTION(binaryTreeMeshIO->ComputeMorphometrics(parallelMorphometrics));
+  constexpr double numberOfSegments = numberOfTreeSamples - 1;
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetNumberOfSamples(), numberOfTreeSamples);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetNumberOfRoots(), 1);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetNumberOfTips(), 1u << 14);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetNumberOfBranchPoints(), (1u << 14) - 1);
+  ITK_TEST_EXPECT_TRUE(IsClose(parallelMorphometrics.GetTotalLength(), 5.0 * numberOfSegments));
+  ITK_TEST_EXPECT_TRUE(IsClose(parallelMorphometrics.GetTotalSurfaceArea(), 10.0 * itk::Math::pi * numberOfSegments));
+  ITK_TEST_EXPECT_TRUE(IsClose(parallelMorphometrics.GetTotalVolume(), 5.0 * itk::Math::pi * numberOfSegments));
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetMinimumPoint()[1], -56.0);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetMaximumPoint()[0], 42.0);
+  ITK_TEST_EXPECT_EQUAL(parallelMorphometrics.GetMaximumPoint()[1], 56.0);
+  const auto & treeTypeMeasures = parallelMorphometrics.GetTypeMeasures();
+  ITK_TEST_EXPECT_EQUAL(treeTypeMeasures.size(), 2);
+  ITK_TEST_EXPECT_EQUAL(treeTypeMeasures[0].NumberOfSamples, (1u << 14) - 1);
+  ITK_TEST_EXPECT_EQUAL(treeTypeMeasures[1].NumberOfSamples, 1u << 14);
+  ITK_TEST_EXPECT_TRUE(IsClose(treeTypeMeasures[0].Length, 2.5 * numberOfSegments));
+  ITK_TEST_EXPECT_TRUE(IsClose(treeTypeMeasures[1].Volume, 2.5 * itk::Math::pi * numberOfSegments));
+
+  // The reconstructions given on the command line, read in double
+  // precision, match the reference measures of their text
+  for (int ii = 2; ii < argc; ++ii)
+  {
+    auto inputMeshIO = itk::SWCMeshIO::New();
+    inputMeshIO->SetFileName(argv[ii]);
+    inputMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::DOUBLE);
+    ITK_TRY_EXPECT_NO_EXCEPTION(inputMeshIO->ReadMeshInformation());
+    ITK_TRY_EXPECT_NO_EXCEPTION(inputMeshIO->ComputeMorphometrics(parallelMorphometrics));
+    std::cout << argv[ii] << std::endl;
+    parallelMorphometrics.Print(std::cout);
+    ITK_TEST_EXPECT_EQUAL(ExpectReferenceMeasures(parallelMorphometrics, ComputeReferenceMeasures(argv[ii])),
+                          EXIT_SUCCESS);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCBinaryMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+namespace
+{
+void
+WriteSWCFile(const std::string & fileName, unsigned int numberOfSamples)
+{
+  std::ofstream outputFile(fileName.c_str(), std::ios::out);
+  outputFile << "# cached\n";
+  for (unsigned int ii = 1; ii <= numberOfSamples; ++ii)
+  {
+    outputFile << ii << " 3 " << ii << " 0 0 1 " << static_cast<int>(ii) - 1 << '\n';
+  }
+}
+} // namespace
+
+int
+itkSWCParsedFileCacheTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  const std::string fileName = outputDirectory + "/itkSWCParsedFileCacheTest.swc";
+  const std::string otherFileName = outputDirectory + "/itkSWCParsedFileCacheTestOther.swc";
+  WriteSWCFile(fileName, 100);
+  WriteSWCFile(otherFileName, 100);
+
+  auto & cache = itk::SWCParsedFileCache::GetInstance();
+  cache.Clear();
+  cache.ResetStatistics();
+
+  // Disabled by default: reading does not touch the cache
+  ITK_TEST_EXPECT_TRUE(!cache.IsEnabled());
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  swcMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfMisses(), 0);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfEntries(), 0);
+
+  cache.SetMaximumSizeInBytes(1 << 20);
+  ITK_TEST_SET_GET_VALUE(1 << 20, cache.GetMaximumSizeInBytes());
+
+  // The first read parses the file, the second one is served by the cache
+  auto firstMeshIO = itk::SWCMeshIO::New();
+  firstMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(firstMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfMisses(), 1);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfEntries(), 1);
+  ITK_TEST_EXPECT_TRUE(cache.GetSizeInBytes() > 0);
+
+  auto secondMeshIO = itk::SWCMeshIO::New();
+  secondMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(secondMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfHits(), 1);
+  ITK_TEST_EXPECT_EQUAL(secondMeshIO->GetNumberOfPoints(), 100);
+  ITK_TEST_EXPECT_EQUAL(secondMeshIO->GetNumberOfCells(), 99);
+  ITK_TEST_EXPECT_TRUE(secondMeshIO->GetHeaderContent() == firstMeshIO->GetHeaderContent());
+  ITK_TEST_EXPECT_TRUE(secondMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer() ==
+                       firstMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer());
+  std::vector<float> firstPoints(300);
+  std::vector<float> secondPoints(300);
+  firstMeshIO->ReadPoints(firstPoints.data());
+  secondMeshIO->ReadPoints(secondPoints.data());
+  ITK_TEST_EXPECT_TRUE(firstPoints == secondPoints);
+
+  // The arrays of the entry are shared, and copied before they are modified
+  ITK_TEST_EXPECT_EQUAL(secondMeshIO->GetRadii(), firstMeshIO->GetRadii());
+  ITK_TEST_EXPECT_EQUAL(secondMeshIO->GetNativeParentIdentifiers(), firstMeshIO->GetNativeParentIdentifiers());
+  secondMeshIO->SetPointDataContent(itk::SWCMeshIOEnums::SWCPointData::Radius);
+  secondMeshIO->SetPointPixelComponentType(itk::IOComponentEnum::DOUBLE);
+  std::vector<double> writtenRadii(100, 9.0);
+  secondMeshIO->WritePointData(static_cast<void *>(writtenRadii.data()));
+  ITK_TEST_EXPECT_TRUE(secondMeshIO->GetRadii() != firstMeshIO->GetRadii());
+  ITK_TEST_EXPECT_EQUAL(firstMeshIO->GetRadii()->GetElement(0), 1.0);
+
+  auto thirdMeshIO = itk::SWCMeshIO::New();
+  thirdMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(thirdMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfHits(), 2);
+  ITK_TEST_EXPECT_EQUAL(thirdMeshIO->GetRadii()->GetElement(0), 1.0);
+
+  // A requested point component type only changes the conversion done by
+  // ReadPoints, and is served by the same entry
+  auto floatMeshIO = itk::SWCMeshIO::New();
+  floatMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::FLOAT);
+  floatMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(floatMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfHits(), 3);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfEntries(), 1);
+
+  // A file that changed on disk is parsed again
+  WriteSWCFile(fileName, 50);
+  thirdMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(thirdMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfMisses(), 2);
+  ITK_TEST_EXPECT_EQUAL(thirdMeshIO->GetNumberOfPoints(), 50);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfEntries(), 1);
+
+  // Each reader class has its own entries
+  const std::string swcbFileName = outputDirectory + "/itkSWCParsedFileCacheTest.swcb";
+  // The conversion parses the coordinates in double precision, which is a
+  // different entry than the read above
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::SWCBinaryMeshIO::ConvertSWCToSWCB(fileName, swcbFileName));
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfHits(), 3);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfMisses(), 3);
+  auto binaryMeshIO = itk::SWCBinaryMeshIO::New();
+  binaryMeshIO->SetFileName(swcbFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(binaryMeshIO->ReadMeshInformation());
+  ITK_TRY_EXPECT_NO_EXCEPTION(binaryMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfHits(), 4);
+  ITK_TEST_EXPECT_EQUAL(binaryMeshIO->GetNumberOfCells(), 49);
+  std::vector<unsigned int> cells(binaryMeshIO->GetCellBufferSize());
+  binaryMeshIO->ReadCells(cells.data());
+  ITK_TEST_EXPECT_EQUAL(cells[4 * 48 + 3], 49);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfEntries(), 3);
+
+  // Reordered reads are cached with their permutation
+  const std::string forestFileName = outputDirectory + "/itkSWCParsedFileCacheTestForest.swc";
+  {
+    std::ofstream outputFile(forestFileName.c_str(), std::ios::out);
+    outputFile << "2 3 1 0 0 1 3\n"
+               << "3 1 0 0 0 1 -1\n"
+               << "1 3 2 0 0 1 2\n";
+  }
+  for (unsigned int ii = 0; ii < 2; ++ii)
+  {
+    auto orderedMeshIO = itk::SWCMeshIO::New();
+    orderedMeshIO->SetSampleOrder(itk::SWCMeshIOEnums::SWCSampleOrder::DepthFirst);
+    orderedMeshIO->SetFileName(forestFileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(orderedMeshIO->ReadMeshInformation());
+    ITK_TEST_EXPECT_TRUE(orderedMeshIO->GetPointPermutation() == std::vector<itk::IdentifierType>({ 1, 0, 2 }));
+    ITK_TEST_EXPECT_EQUAL(orderedMeshIO->GetNativeSampleIdentifiers()->GetElement(0), 3);
+  }
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfHits(), 5);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfEntries(), 4);
+
+  // Least recently used entries are evicted to stay within the budget
+  const itk::SizeValueType sizeInBytes = cache.GetSizeInBytes();
+  cache.SetMaximumSizeInBytes(sizeInBytes);
+  auto otherMeshIO = itk::SWCMeshIO::New();
+  otherMeshIO->SetFileName(otherFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(otherMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(cache.GetNumberOfEvictions() > 0);
+  ITK_TEST_EXPECT_TRUE(cache.GetSizeInBytes() <= sizeInBytes);
+  ITK_TRY_EXPECT_NO_EXCEPTION(otherMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfHits(), 6);
+
+  cache.SetMaximumSizeInBytes(0);
+  ITK_TEST_EXPECT_EQUAL(cache.GetNumberOfEntries(), 0);
+  ITK_TEST_EXPECT_EQUAL(cache.GetSizeInBytes(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
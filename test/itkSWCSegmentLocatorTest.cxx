@@ -0,0 +1,312 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCMeshIO.h"
+#include "itkSWCSegmentLocator.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+
+namespace
+{
+using PointType = itk::SWCSegmentLocator::PointType;
+
+// Distances of a query point to every segment, from the points and line
+// cells read through the MeshIOBase interface. Roots are spheres.
+class BruteForceLocator
+{
+public:
+  explicit BruteForceLocator(itk::SWCMeshIO * swcMeshIO)
+  {
+    const itk::SizeValueType numberOfPoints = swcMeshIO->GetNumberOfPoints();
+    std::vector<unsigned int> cells(swcMeshIO->GetCellBufferSize());
+    m_Points.resize(3 * numberOfPoints);
+    swcMeshIO->ReadPoints(m_Points.data());
+    swcMeshIO->ReadCells(cells.data());
+    m_Radii = swcMeshIO->GetRadii()->CastToSTLConstContainer();
+    m_Parents.resize(numberOfPoints);
+    for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+    {
+      m_Parents[ii] = ii;
+    }
+    for (itk::SizeValueType ii = 0; ii < cells.size(); ii += 4)
+    {
+      m_Parents[cells[ii + 3]] = cells[ii + 2];
+    }
+  }
+
+  itk::SizeValueType
+  GetNumberOfSegments() const
+  {
+    return m_Parents.size();
+  }
+
+  double
+  ComputeDistance(const PointType & point, itk::SizeValueType pointIndex) const
+  {
+    const itk::SizeValueType parentIndex = m_Parents[pointIndex];
+    double                   a[3];
+    double                   b[3];
+    double                   ab = 0.0;
+    double                   bb = 0.0;
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      a[jj] = point[jj] - m_Points[3 * pointIndex + jj];
+      b[jj] = static_cast<double>(m_Points[3 * parentIndex + jj]) - m_Points[3 * pointIndex + jj];
+      ab += a[jj] * b[jj];
+      bb += b[jj] * b[jj];
+    }
+    const double t = bb > 0.0 ? std::min(1.0, std::max(0.0, ab / bb)) : 0.0;
+    double       squaredDistance = 0.0;
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      squaredDistance += (a[jj] - t * b[jj]) * (a[jj] - t * b[jj]);
+    }
+    const double radius = (1.0 - t) * m_Radii[pointIndex] + t * m_Radii[parentIndex];
+    return std::max(0.0, std::sqrt(squaredDistance) - radius);
+  }
+
+  double
+  FindNearestDistance(const PointType & point) const
+  {
+    double nearestDistance = std::numeric_limits<double>::infinity();
+    for (itk::SizeValueType ii = 0; ii < m_Parents.size(); ++ii)
+    {
+      nearestDistance = std::min(nearestDistance, this->ComputeDistance(point, ii));
+    }
+    return nearestDistance;
+  }
+
+  PointType
+  GetPoint(itk::SizeValueType pointIndex) const
+  {
+    return { m_Points[3 * pointIndex], m_Points[3 * pointIndex + 1], m_Points[3 * pointIndex + 2] };
+  }
+
+private:
+  std::vector<float>              m_Points;
+  std::vector<double>             m_Radii;
+  std::vector<itk::SizeValueType> m_Parents;
+};
+
+bool
+IsClose(double value, double expected)
+{
+  return std::abs(value - expected) <= 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+// Compare numberOfQueries nearest segment and radius queries around the
+// samples of the reconstruction to a brute force search.
+bool
+CheckAgainstBruteForce(const itk::SWCSegmentLocator & locator,
+                       const BruteForceLocator &      bruteForce,
+                       unsigned int                   numberOfQueries)
+{
+  std::mt19937                           generator(42);
+  std::uniform_int_distribution<size_t> sampleDistribution(0, bruteForce.GetNumberOfSegments() - 1);
+  std::uniform_real_distribution<double> offsetDistribution(-20.0, 20.0);
+  std::vector<double>                    queryPoints(3 * numberOfQueries);
+  for (unsigned int ii = 0; ii < numberOfQueries; ++ii)
+  {
+    const PointType sample = bruteForce.GetPoint(sampleDistribution(generator));
+    for (unsigned int jj = 0; jj < 3; ++jj)
+    {
+      queryPoints[3 * ii + jj] = sample[jj] + offsetDistribution(generator);
+    }
+  }
+  std::vector<itk::SWCSegmentLocator::QueryResultType> results(numberOfQueries);
+  locator.FindNearestSegments(queryPoints.data(), numberOfQueries, results.data());
+
+  bool                                           passed = true;
+  itk::SWCSegmentLocator::QueryResultContainerType withinDistance;
+  for (unsigned int ii = 0; ii < numberOfQueries; ++ii)
+  {
+    const PointType queryPoint{ queryPoints[3 * ii], queryPoints[3 * ii + 1], queryPoints[3 * ii + 2] };
+    const double    nearestDistance = bruteForce.FindNearestDistance(queryPoint);
+    if (!IsClose(results[ii].Distance, nearestDistance) ||
+        !IsClose(bruteForce.ComputeDistance(queryPoint, results[ii].PointIndex), nearestDistance))
+    {
+      std::cerr << "Nearest segment of query " << ii << ": " << results[ii].PointIndex << " at "
+                << results[ii].Distance << ". Expected distance " << nearestDistance << std::endl;
+      passed = false;
+    }
+
+    const double distance = nearestDistance + 2.0;
+    locator.FindSegmentsWithinDistance(queryPoint, distance, withinDistance);
+    itk::SizeValueType expectedNumberOfSegments = 0;
+    for (itk::SizeValueType jj = 0; jj < bruteForce.GetNumberOfSegments(); ++jj)
+    {
+      expectedNumberOfSegments += bruteForce.ComputeDistance(queryPoint, jj) <= distance;
+    }
+    if (withinDistance.size() != expectedNumberOfSegments)
+    {
+      std::cerr << "Query " << ii << " found " << withinDistance.size() << " segments within " << distance
+                << ". Expected " << expectedNumberOfSegments << std::endl;
+      passed = false;
+    }
+  }
+  return passed;
+}
+} // namespace
+
+int
+itkSWCSegmentLocatorTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory [inputFile ...]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // A soma with a branch that turns at a right angle
+  const std::string fileName = outputDirectory + "/itkSWCSegmentLocatorTest.swc";
+  {
+    std::ofstream outputFile(fileName.c_str(), std::ios::out);
+    outputFile << "1 1 0 0 0 1 -1\n"
+               << "2 3 10 0 0 1 1\n"
+               << "3 3 10 10 0 0.5 2\n";
+  }
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  swcMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  itk::SWCSegmentLocator locator;
+  itk::SWCSegmentLocator::QueryResultType result;
+  ITK_TEST_EXPECT_TRUE(!locator.FindNearestSegment({ 0.0, 0.0, 0.0 }, result));
+  ITK_TEST_EXPECT_EQUAL(result.PointIndex, itk::SWCSegmentLocator::InvalidIndex);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->BuildSegmentLocator(locator));
+  ITK_TEST_EXPECT_EQUAL(locator.GetNumberOfSegments(), 3);
+  ITK_TEST_EXPECT_EQUAL(locator.GetNumberOfNodes(), 1);
+
+  ITK_TEST_EXPECT_TRUE(locator.FindNearestSegment({ 5.0, 3.0, 0.0 }, result));
+  ITK_TEST_EXPECT_EQUAL(result.PointIndex, 1);
+  ITK_TEST_EXPECT_TRUE(IsClose(result.Distance, 2.0));
+  ITK_TEST_EXPECT_TRUE(IsClose(result.AxisDistance, 3.0));
+  ITK_TEST_EXPECT_TRUE(IsClose(result.Parameter, 0.5));
+
+  // Inside both the soma and the first segment, on the soma center line
+  ITK_TEST_EXPECT_TRUE(locator.FindNearestSegment({ 0.0, 0.0, 0.5 }, result));
+  ITK_TEST_EXPECT_EQUAL(result.PointIndex, 0);
+  ITK_TEST_EXPECT_EQUAL(result.Distance, 0.0);
+  ITK_TEST_EXPECT_TRUE(IsClose(result.AxisDistance, 0.5));
+
+  // The radius is interpolated from the sample to its parent
+  ITK_TEST_EXPECT_TRUE(locator.FindNearestSegment({ 12.0, 7.0, 0.0 }, result));
+  ITK_TEST_EXPECT_EQUAL(result.PointIndex, 2);
+  ITK_TEST_EXPECT_TRUE(IsClose(result.Parameter, 0.3));
+  ITK_TEST_EXPECT_TRUE(IsClose(result.Distance, 2.0 - 0.65));
+
+  itk::SWCSegmentLocator::QueryResultContainerType results;
+  locator.FindSegmentsWithinDistance({ 10.0, 5.0, 0.0 }, 0.5, results);
+  ITK_TEST_EXPECT_EQUAL(results.size(), 1);
+  ITK_TEST_EXPECT_EQUAL(results[0].PointIndex, 2);
+  locator.FindSegmentsWithinDistance({ 10.0, 5.0, 0.0 }, 4.0, results);
+  ITK_TEST_EXPECT_EQUAL(results.size(), 2);
+  ITK_TEST_EXPECT_EQUAL(results[0].PointIndex, 1);
+  ITK_TEST_EXPECT_EQUAL(results[1].PointIndex, 2);
+  locator.FindSegmentsWithinDistance({ 10.0, 5.0, 0.0 }, -1.0, results);
+  ITK_TEST_EXPECT_TRUE(results.empty());
+
+  // Double precision points and the parent indices of the topology
+  swcMeshIO->SetRequestedPointComponentType(itk::IOComponentEnum::DOUBLE);
+  swcMeshIO->ComputeTopologyOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->BuildSegmentLocator(locator));
+  ITK_TEST_EXPECT_TRUE(locator.FindNearestSegment({ 5.0, 3.0, 0.0 }, result));
+  ITK_TEST_EXPECT_EQUAL(result.PointIndex, 1);
+  swcMeshIO->ReleaseBuffers();
+  ITK_TRY_EXPECT_EXCEPTION(swcMeshIO->BuildSegmentLocator(locator));
+
+  // A larger tree is built in parallel into the same hierarchy
+  const std::string      largeFileName = outputDirectory + "/itkSWCSegmentLocatorTestLarge.swc";
+  constexpr unsigned int numberOfLargeSamples = 20000;
+  {
+    std::ofstream outputFile(largeFileName.c_str(), std::ios::out);
+    for (unsigned int ii = 1; ii <= numberOfLargeSamples; ++ii)
+    {
+      outputFile << ii << ' ' << 2 + ii % 3 << ' ' << 0.5 * ii << ' ' << ii % 7 << ' ' << ii % 11 << ' '
+                 << 0.25 + 0.01 * (ii % 13) << ' ' << (ii == 1 ? -1 : static_cast<int>(ii / 2)) << '\n';
+    }
+  }
+  auto largeMeshIO = itk::SWCMeshIO::New();
+  largeMeshIO->SetFileName(largeFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(largeMeshIO->ReadMeshInformation());
+  largeMeshIO->BuildSegmentLocator(locator);
+  itk::SWCSegmentLocator parallelLocator;
+  parallelLocator.SetNumberOfWorkUnits(4);
+  ITK_TEST_EXPECT_EQUAL(parallelLocator.GetNumberOfWorkUnits(), 4);
+  largeMeshIO->BuildSegmentLocator(parallelLocator);
+  ITK_TEST_EXPECT_EQUAL(parallelLocator.GetNumberOfSegments(), numberOfLargeSamples);
+  std::ostringstream serialStream;
+  std::ostringstream parallelStream;
+  locator.Write(serialStream);
+  parallelLocator.Write(parallelStream);
+  ITK_TEST_EXPECT_TRUE(serialStream.str() == parallelStream.str());
+  const BruteForceLocator largeBruteForce(largeMeshIO);
+  ITK_TEST_EXPECT_TRUE(CheckAgainstBruteForce(parallelLocator, largeBruteForce, 500));
+
+  // Serialization restores the hierarchy without the samples
+  itk::SWCSegmentLocator readLocator;
+  std::istringstream     inputStream(serialStream.str());
+  ITK_TRY_EXPECT_NO_EXCEPTION(readLocator.Read(inputStream));
+  ITK_TEST_EXPECT_EQUAL(readLocator.GetNumberOfNodes(), locator.GetNumberOfNodes());
+  std::ostringstream rewrittenStream;
+  readLocator.Write(rewrittenStream);
+  ITK_TEST_EXPECT_TRUE(rewrittenStream.str() == serialStream.str());
+  ITK_TEST_EXPECT_TRUE(CheckAgainstBruteForce(readLocator, largeBruteForce, 100));
+
+  std::istringstream truncatedStream(serialStream.str().substr(0, serialStream.str().size() / 2));
+  ITK_TRY_EXPECT_EXCEPTION(readLocator.Read(truncatedStream));
+  ITK_TEST_EXPECT_EQUAL(readLocator.GetNumberOfSegments(), 0);
+  std::istringstream invalidStream("SWCB");
+  ITK_TRY_EXPECT_EXCEPTION(readLocator.Read(invalidStream));
+  // Point the first child of the root back to the root
+  std::string cyclicContent = serialStream.str();
+  std::memset(&cyclicContent[24 + 48 * locator.GetNumberOfNodes()], 0, 8);
+  std::istringstream cyclicStream(cyclicContent);
+  ITK_TRY_EXPECT_EXCEPTION(readLocator.Read(cyclicStream));
+  // Counts larger than the stream are rejected before allocating the sections
+  std::string oversizedContent = serialStream.str();
+  for (unsigned int ii = 0; ii < 8; ++ii)
+  {
+    oversizedContent[8 + ii] = oversizedContent[16 + ii] = ii == 5 ? 1 : 0;
+  }
+  std::istringstream oversizedStream(oversizedContent);
+  ITK_TRY_EXPECT_EXCEPTION(readLocator.Read(oversizedStream));
+
+  // The reconstructions given on the command line match a brute force search
+  for (int ii = 2; ii < argc; ++ii)
+  {
+    auto inputMeshIO = itk::SWCMeshIO::New();
+    inputMeshIO->SetFileName(argv[ii]);
+    ITK_TRY_EXPECT_NO_EXCEPTION(inputMeshIO->ReadMeshInformation());
+    inputMeshIO->BuildSegmentLocator(parallelLocator);
+    std::cout << argv[ii] << ": " << parallelLocator.GetNumberOfSegments() << " segments, "
+              << parallelLocator.GetNumberOfNodes() << " nodes" << std::endl;
+    ITK_TEST_EXPECT_TRUE(CheckAgainstBruteForce(parallelLocator, BruteForceLocator(inputMeshIO), 200));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
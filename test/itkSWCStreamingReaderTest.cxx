@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCMeshIO.h"
+#include "itkSWCStreamingReader.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+int
+itkSWCStreamingReaderTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  constexpr unsigned int numberOfSamples = 1000;
+  const std::string      fileName = outputDirectory + "/itkSWCStreamingReaderTest.swc";
+  {
+    std::ofstream outputFile(fileName.c_str(), std::ios::out);
+    outputFile << "# streamed\n";
+    for (unsigned int ii = 1; ii <= numberOfSamples; ++ii)
+    {
+      outputFile << ii << ' ' << ii % 4 << ' ' << ii << " 0 0 " << 0.25 * ii << ' ' << static_cast<int>(ii) - 1 << '\n';
+      if (ii == 500)
+      {
+        outputFile << "# halfway\n";
+      }
+    }
+  }
+
+  auto streamingReader = itk::SWCStreamingReader::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(streamingReader, SWCStreamingReader, Object);
+
+  streamingReader->SetFileName(fileName);
+  ITK_TEST_SET_GET_VALUE(fileName, std::string(streamingReader->GetFileName()));
+  streamingReader->SetBatchSize(64);
+  ITK_TEST_SET_GET_VALUE(64, streamingReader->GetBatchSize());
+
+  std::vector<std::string> headerLines;
+  streamingReader->SetHeaderLineCallback([&headerLines](const std::string & headerLine) {
+    headerLines.push_back(headerLine);
+  });
+
+  // Accumulate statistics batch by batch
+  itk::SizeValueType  numberOfBatches = 0;
+  itk::SizeValueType  maximumBatchSize = 0;
+  itk::SizeValueType  nextSampleIndex = 0;
+  bool                isContiguous = true;
+  double              radiusSum = 0.0;
+  double              xSum = 0.0;
+  std::vector<double> typeCounts(4);
+  streamingReader->SetSampleBatchCallback([&](const itk::SWCParser::SampleBuffers & samples,
+                                              itk::SizeValueType                    firstSampleIndex) {
+    ++numberOfBatches;
+    maximumBatchSize = std::max(maximumBatchSize, samples.Size());
+    isContiguous = isContiguous && firstSampleIndex == nextSampleIndex;
+    nextSampleIndex = firstSampleIndex + samples.Size();
+    for (itk::SizeValueType ii = 0; ii < samples.Size(); ++ii)
+    {
+      radiusSum += samples.Radii[ii];
+      xSum += samples.Points[3 * ii];
+      ++typeCounts[static_cast<unsigned int>(samples.TypeIdentifiers[ii])];
+    }
+  });
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+
+  ITK_TEST_EXPECT_EQUAL(streamingReader->GetNumberOfSamples(), numberOfSamples);
+  ITK_TEST_EXPECT_EQUAL(streamingReader->GetNumberOfLines(), numberOfSamples + 2);
+  ITK_TEST_EXPECT_EQUAL(numberOfBatches, 16);
+  ITK_TEST_EXPECT_EQUAL(maximumBatchSize, 64);
+  ITK_TEST_EXPECT_TRUE(isContiguous);
+  ITK_TEST_EXPECT_EQUAL(typeCounts[1], 250);
+
+  // The visited samples match what SWCMeshIO reads
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  swcMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(headerLines == swcMeshIO->GetHeaderContent());
+  double expectedRadiusSum = 0.0;
+  for (const auto radius : swcMeshIO->GetRadii()->CastToSTLConstContainer())
+  {
+    expectedRadiusSum += radius;
+  }
+  ITK_TEST_EXPECT_EQUAL(radiusSum, expectedRadiusSum);
+  ITK_TEST_EXPECT_EQUAL(xSum, 0.5 * numberOfSamples * (numberOfSamples + 1));
+
+  // Samples before an invalid line are visited, then an exception is thrown
+  const std::string invalidFileName = outputDirectory + "/itkSWCStreamingReaderTestInvalid.swc";
+  {
+    std::ofstream outputFile(invalidFileName.c_str(), std::ios::out);
+    outputFile << "1 1 0 0 0 1 -1\n"
+               << "2 1 0 0 0 1 1\n"
+               << "3 1 0 0\n";
+  }
+  streamingReader->SetFileName(invalidFileName);
+  streamingReader->SetHeaderLineCallback(nullptr);
+  nextSampleIndex = 0;
+  ITK_TRY_EXPECT_EXCEPTION(streamingReader->Update());
+  ITK_TEST_EXPECT_EQUAL(nextSampleIndex, 2);
+  ITK_TEST_EXPECT_EQUAL(streamingReader->GetNumberOfLines(), 3);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSWCMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+int
+itkSWCValidationReportTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  using ErrorCode = itk::SWCValidationReport::ErrorCode;
+
+  const std::string fileName = outputDirectory + "/itkSWCValidationReportTest.swc";
+  {
+    std::ofstream outputFile(fileName.c_str(), std::ios::out);
+    outputFile << "# invalid structure\n"
+               << "1 1 0 0 0 1 -1\n"
+               << "2 3 0 0 0 1 1\n"
+               << "3 3 0 0 0 1 42\n"
+               << "2 3 0 0 0 1 1\n"
+               << "5 1 0 0 0 1 -1\n"
+               << "\n"
+               << "6 3 0 0 0 1 7\n"
+               << "7 3 0 0 0 1 6\n"
+               << "8 3 0 0 0 1 8\n"
+               << "9 3 0 0 0 1 6\n";
+  }
+
+  auto swcMeshIO = itk::SWCMeshIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(swcMeshIO, ValidateSamples, false);
+  ITK_TEST_SET_GET_BOOLEAN(swcMeshIO, ThrowOnValidationError, false);
+  swcMeshIO->SetFileName(fileName);
+
+  // Validation is off by default
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(swcMeshIO->GetValidationReport().IsValid());
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetValidationReport().GetNumberOfSamples(), 0);
+
+  swcMeshIO->ValidateSamplesOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  const itk::SWCValidationReport & report = swcMeshIO->GetValidationReport();
+  report.Print(std::cout);
+  ITK_TEST_EXPECT_TRUE(!report.IsValid());
+  ITK_TEST_EXPECT_EQUAL(report.GetNumberOfSamples(), 9);
+  ITK_TEST_EXPECT_EQUAL(report.GetNumberOfIssues(), 5);
+  ITK_TEST_EXPECT_EQUAL(report.GetNumberOfRoots(), 2);
+  ITK_TEST_EXPECT_EQUAL(report.GetNumberOfMissingParents(), 1);
+  ITK_TEST_EXPECT_EQUAL(report.GetNumberOfDuplicateIdentifiers(), 1);
+  ITK_TEST_EXPECT_EQUAL(report.GetNumberOfCycles(), 2);
+  ITK_TEST_EXPECT_EQUAL(report.GetNumberOfPointsOnCycles(), 3);
+
+  const auto & issues = report.GetIssues();
+  ITK_TEST_EXPECT_EQUAL(issues.size(), 5);
+  ITK_TEST_EXPECT_TRUE(issues[0].Code == ErrorCode::DuplicateIdentifier);
+  ITK_TEST_EXPECT_EQUAL(issues[0].LineNumber, 3);
+  ITK_TEST_EXPECT_EQUAL(issues[0].PointIndex, 1);
+  ITK_TEST_EXPECT_TRUE(issues[1].Code == ErrorCode::MissingParent);
+  ITK_TEST_EXPECT_EQUAL(issues[1].LineNumber, 4);
+  ITK_TEST_EXPECT_EQUAL(issues[1].ParentIdentifier, 42);
+  ITK_TEST_EXPECT_TRUE(issues[2].Code == ErrorCode::MultipleRoots);
+  ITK_TEST_EXPECT_EQUAL(issues[2].LineNumber, 6);
+  ITK_TEST_EXPECT_TRUE(issues[3].Code == ErrorCode::Cycle);
+  ITK_TEST_EXPECT_EQUAL(issues[3].LineNumber, 8);
+  ITK_TEST_EXPECT_EQUAL(issues[3].SampleIdentifier, 6);
+  ITK_TEST_EXPECT_TRUE(issues[4].Code == ErrorCode::Cycle);
+  ITK_TEST_EXPECT_EQUAL(issues[4].LineNumber, 10);
+
+  // The parallel parse reports the same line numbers
+  auto parallelMeshIO = itk::SWCMeshIO::New();
+  parallelMeshIO->SetNumberOfWorkUnits(4);
+  parallelMeshIO->ValidateSamplesOn();
+  parallelMeshIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelMeshIO->ReadMeshInformation());
+  const auto & parallelIssues = parallelMeshIO->GetValidationReport().GetIssues();
+  ITK_TEST_EXPECT_EQUAL(parallelIssues.size(), issues.size());
+  for (size_t ii = 0; ii < issues.size(); ++ii)
+  {
+    ITK_TEST_EXPECT_TRUE(parallelIssues[ii].Code == issues[ii].Code);
+    ITK_TEST_EXPECT_EQUAL(parallelIssues[ii].LineNumber, issues[ii].LineNumber);
+  }
+
+  // The samples are checked before the region of interest and the subtree
+  // select from them, so the report still describes the whole file
+  for (const unsigned int selection : { 0u, 1u, 2u, 3u })
+  {
+    auto selectionMeshIO = itk::SWCMeshIO::New();
+    selectionMeshIO->SetNumberOfWorkUnits(selection % 2 ? 4 : 1);
+    if (selection < 2)
+    {
+      // Every sample is outside of the region
+      selectionMeshIO->UseRegionOfInterestOn();
+      selectionMeshIO->SetRegionOfInterestMinimum({ { 1.0, 1.0, 1.0 } });
+      selectionMeshIO->SetRegionOfInterestMaximum({ { 2.0, 2.0, 2.0 } });
+    }
+    else
+    {
+      selectionMeshIO->SetSubtreeRootIdentifier(5);
+    }
+    selectionMeshIO->ValidateSamplesOn();
+    selectionMeshIO->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(selectionMeshIO->ReadMeshInformation());
+    ITK_TEST_EXPECT_EQUAL(selectionMeshIO->GetNumberOfPoints(), selection < 2 ? 0 : 1);
+    const auto & selectionReport = selectionMeshIO->GetValidationReport();
+    ITK_TEST_EXPECT_EQUAL(selectionReport.GetNumberOfSamples(), 9);
+    ITK_TEST_EXPECT_EQUAL(selectionReport.GetIssues().size(), issues.size());
+    for (size_t ii = 0; ii < issues.size(); ++ii)
+    {
+      ITK_TEST_EXPECT_TRUE(selectionReport.GetIssues()[ii].Code == issues[ii].Code);
+      ITK_TEST_EXPECT_EQUAL(selectionReport.GetIssues()[ii].PointIndex, issues[ii].PointIndex);
+      ITK_TEST_EXPECT_EQUAL(selectionReport.GetIssues()[ii].LineNumber, issues[ii].LineNumber);
+    }
+  }
+
+  // Only the first MaximumNumberOfIssues are recorded, all are counted
+  itk::SWCValidationReport limitedReport;
+  limitedReport.SetMaximumNumberOfIssues(2);
+  ITK_TEST_EXPECT_EQUAL(limitedReport.GetMaximumNumberOfIssues(), 2);
+  itk::SWCIdentifierIndex sampleIdentifierIndex;
+  const auto *            sampleIdentifiers = swcMeshIO->GetNativeSampleIdentifiers()->CastToSTLConstContainer().data();
+  sampleIdentifierIndex.Build(sampleIdentifiers, 9);
+  limitedReport.Compute(sampleIdentifiers,
+                        swcMeshIO->GetNativeParentIdentifiers()->CastToSTLConstContainer().data(),
+                        9,
+                        sampleIdentifierIndex,
+                        nullptr);
+  ITK_TEST_EXPECT_EQUAL(limitedReport.GetIssues().size(), 2);
+  ITK_TEST_EXPECT_EQUAL(limitedReport.GetNumberOfIssues(), 5);
+  ITK_TEST_EXPECT_EQUAL(limitedReport.GetIssues()[1].LineNumber, 0);
+
+  swcMeshIO->ThrowOnValidationErrorOn();
+  ITK_TRY_EXPECT_EXCEPTION(swcMeshIO->ReadMeshInformation());
+
+  // A well formed tree passes
+  const std::string validFileName = outputDirectory + "/itkSWCValidationReportTestValid.swc";
+  {
+    std::ofstream outputFile(validFileName.c_str(), std::ios::out);
+    outputFile << "3 3 0 0 0 1 1\n"
+               << "1 1 0 0 0 1 -1\n"
+               << "2 3 0 0 0 1 1\n";
+  }
+  swcMeshIO->SetFileName(validFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(swcMeshIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_TRUE(swcMeshIO->GetValidationReport().IsValid());
+  ITK_TEST_EXPECT_EQUAL(swcMeshIO->GetValidationReport().GetNumberOfRoots(), 1);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}